@@ -0,0 +1,269 @@
+/*
+ * concurrent priority queue benchmark
+ *
+ * `MultiQueue` against a `PriorityQueue` behind a single mutex, for each
+ * thread count of `--threads`:
+ * 1. throughput: the queue is filled with `--prefill` random keys, then
+ *    every thread alternates a push of a random key and a pop, `--ops`
+ *    times. reported in million operations per second, the best of `--reps`
+ *    runs.
+ * 2. rank error: the queue is filled with the keys `0 .. n - 1`, then the
+ *    threads pop all of them, each pop taking a ticket from a shared counter.
+ *    the `t`-th pop of an exact queue is key `t`, so `|key - t|` is its rank
+ *    error, up to the order in which tickets and pops interleave. reported
+ *    as mean and max. with more threads than cores, a thread preempted while
+ *    holding the lock of a heap holds back its items for a whole time slice,
+ *    which shows as a much larger error.
+ * results are printed as a table, and written as JSON with `--json`.
+ *
+ * usage: pq_bench [--threads a,b,..] [--ops N] [--prefill N] [--reps R]
+ *                 [--c C] [--seed S] [--json FILE]
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <parallel/multiqueue.hpp>
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <sort/heap.hpp>
+#include <time/timer.hpp>
+
+#ifndef ALG_VERSION
+#define ALG_VERSION "unknown"
+#endif
+
+namespace {
+struct Options {
+  // powers of two up to all hardware threads
+  std::vector<size_t> threads;
+  size_t ops = size_t(1) << 20;
+  size_t prefill = size_t(1) << 20;
+  size_t reps = 3;
+  size_t c = 2;
+  uint64_t seed = 1;
+  std::string json;
+};
+
+// `PriorityQueue` behind a single lock, the interface of `MultiQueue`
+class LockedQueue {
+  alg::PriorityQueue<uint64_t> pq_;
+  std::mutex mu_;
+
+ public:
+  void push(uint64_t const x) {
+    std::lock_guard<std::mutex> lk(mu_);
+    pq_.push(x);
+  }
+
+  std::optional<uint64_t> try_pop() {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (pq_.size() == 0) {
+      return std::nullopt;
+    }
+    return pq_.pop();
+  }
+};
+
+struct Result {
+  std::string queue;
+  size_t threads;
+  double mops;
+  double mean_rank_error;
+  uint64_t max_rank_error;
+};
+
+void print(Result const& r) {
+  std::printf("%-12s %8zu %12.2f %12.2f %12llu\n", r.queue.c_str(),
+              r.threads, r.mops, r.mean_rank_error,
+              static_cast<unsigned long long>(r.max_rank_error));
+  std::fflush(stdout);
+}
+
+// run `f(t)` on `n` tasks at once
+void on_threads(alg::Scheduler& sched,
+                size_t const n,
+                std::function<void(size_t)> const& f) {
+  alg::TaskGroup tg(sched);
+  for (size_t t = 0; t < n; t++) {
+    tg.run([&f, t] { f(t); });
+  }
+  tg.wait();
+}
+
+// `make()` gives a new, empty queue
+template <typename Make>
+double throughput(Options const& opt,
+                  alg::Scheduler& sched,
+                  size_t const p,
+                  Make const& make) {
+  double best = 0;
+  for (size_t r = 0; r < opt.reps; r++) {
+    auto const q = make();
+    alg::Xoshiro256 g(opt.seed + r);
+    for (size_t i = 0; i < opt.prefill; i++) {
+      q->push(g() >> 1);
+    }
+    alg::Timer<HightResolutionClock> timer;
+    timer.start();
+    on_threads(sched, p, [&](size_t const t) {
+      alg::Xoshiro256 gt(opt.seed + r + 1 + t);
+      for (size_t i = 0; i < opt.ops / p; i++) {
+        q->push(gt() >> 1);
+        q->try_pop();
+      }
+    });
+    timer.stop();
+    best = std::max(best, 2e-6 * static_cast<double>(opt.ops / p * p) /
+                              timer.seconds());
+  }
+  return best;
+}
+
+template <typename Make>
+std::pair<double, uint64_t> rank_error(Options const& opt,
+                                       alg::Scheduler& sched,
+                                       size_t const p,
+                                       Make const& make) {
+  auto const q = make();
+  for (uint64_t i = 0; i < opt.prefill; i++) {
+    q->push(i);
+  }
+  std::atomic<uint64_t> ticket{0};
+  std::vector<uint64_t> sum(p, 0), max(p, 0);
+  on_threads(sched, p, [&](size_t const t) {
+    while (std::optional<uint64_t> x = q->try_pop()) {
+      uint64_t const k = ticket.fetch_add(1, std::memory_order_relaxed);
+      uint64_t const e = *x > k ? *x - k : k - *x;
+      sum[t] += e;
+      max[t] = std::max(max[t], e);
+    }
+  });
+  uint64_t s = 0, m = 0;
+  for (size_t t = 0; t < p; t++) {
+    s += sum[t];
+    m = std::max(m, max[t]);
+  }
+  return {static_cast<double>(s) / static_cast<double>(opt.prefill), m};
+}
+
+template <typename Make>
+Result run(Options const& opt,
+           alg::Scheduler& sched,
+           std::string const& name,
+           size_t const p,
+           Make const& make) {
+  auto const [mean, max] = rank_error(opt, sched, p, make);
+  Result res{name, p, throughput(opt, sched, p, make), mean, max};
+  print(res);
+  return res;
+}
+
+std::string json(Options const& opt, std::vector<Result> const& results) {
+  std::ostringstream os;
+  os.precision(6);
+  os << "{\n  \"version\": \"" << ALG_VERSION << "\",\n"
+     << "  \"seed\": " << opt.seed << ",\n"
+     << "  \"ops\": " << opt.ops << ",\n"
+     << "  \"prefill\": " << opt.prefill << ",\n"
+     << "  \"c\": " << opt.c << ",\n"
+     << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    Result const& r = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"queue\": \"" << r.queue
+       << "\", \"threads\": " << r.threads << ", \"mops\": " << r.mops
+       << ", \"mean_rank_error\": " << r.mean_rank_error
+       << ", \"max_rank_error\": " << r.max_rank_error << "}";
+  }
+  os << "\n  ]\n}\n";
+  return os.str();
+}
+
+std::vector<size_t> split(std::string const& s) {
+  std::vector<size_t> r;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      r.push_back(std::stoull(item));
+    }
+  }
+  return r;
+}
+
+Options parse(int const argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; i++) {
+    std::string const arg = argv[i];
+    if (i + 1 >= argc) {
+      throw std::runtime_error("missing value of " + arg);
+    }
+    std::string const value = argv[++i];
+    if (arg == "--threads") {
+      opt.threads = split(value);
+    } else if (arg == "--ops") {
+      opt.ops = std::stoull(value);
+    } else if (arg == "--prefill") {
+      opt.prefill = std::stoull(value);
+    } else if (arg == "--reps") {
+      opt.reps = std::stoull(value);
+    } else if (arg == "--c") {
+      opt.c = std::stoull(value);
+    } else if (arg == "--seed") {
+      opt.seed = std::stoull(value);
+    } else if (arg == "--json") {
+      opt.json = value;
+    } else {
+      throw std::runtime_error("unknown option " + arg);
+    }
+  }
+  if (opt.threads.empty()) {
+    for (size_t p = 1; p <= alg::Scheduler::default_concurrency(); p *= 2) {
+      opt.threads.push_back(p);
+    }
+  }
+  if (opt.reps == 0 || opt.c == 0 ||
+      std::find(opt.threads.begin(), opt.threads.end(), 0) !=
+          opt.threads.end()) {
+    throw std::runtime_error("--threads, --reps and --c must be positive");
+  }
+  return opt;
+}
+};  // namespace
+
+int main(int argc, char* argv[]) {
+  Options const opt = parse(argc, argv);
+  std::vector<Result> results;
+
+  std::printf("%-12s %8s %12s %12s %12s\n", "queue", "threads", "Mops/s",
+              "mean rank", "max rank");
+  for (size_t const p : opt.threads) {
+    alg::Scheduler sched(p);
+    results.push_back(run(opt, sched, "multiqueue", p, [&] {
+      return std::make_unique<alg::MultiQueue<uint64_t>>(p, opt.c);
+    }));
+    results.push_back(run(opt, sched, "locked_pq", p,
+                          [] { return std::make_unique<LockedQueue>(); }));
+  }
+
+  if (!opt.json.empty()) {
+    FILE* f = std::fopen(opt.json.c_str(), "w");
+    if (f == nullptr) {
+      throw std::runtime_error("cannot open " + opt.json);
+    }
+    std::string const s = json(opt, results);
+    std::fwrite(s.data(), 1, s.size(), f);
+    std::fclose(f);
+  }
+  return 0;
+}
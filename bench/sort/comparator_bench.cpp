@@ -0,0 +1,229 @@
+/*
+ * comparator benchmark
+ *
+ * the same structures with the comparator or hasher given as a function
+ * pointer and as a function object, whose calls are inlined into the hot
+ * loops:
+ * 1. `LinearProbing`: `Hash<int>::hash` and `Order<int>::equal` against
+ *    `Hasher<int>` and `std::equal_to<int>`, `--n` puts then `--n` gets
+ * 2. `LLRB`: `Order<int>::default_three_way_comparator` against a lambda,
+ *    `--n` puts then `--n` gets
+ * 3. `QuickX` and `Merge` of `--n` random `int64_t`: `Order<T>::greater`, a
+ *    pointer fixed as a template argument, against `std::greater<T>` and a
+ *    lambda. descending, so that no variant takes the sorting networks or
+ *    the vectorized partition of the ascending order.
+ * reported in ms, the best of `--reps` runs, with the time of the function
+ * pointer over the time of each variant. results are printed as a table,
+ * and written as JSON with `--json`.
+ *
+ * usage: comparator_bench [--n N] [--reps R] [--seed S] [--json FILE]
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <random/prng.hpp>
+#include <search/common.hpp>
+#include <search/linear_probing.hpp>
+#include <search/llrb.hpp>
+#include <sort/common.hpp>
+#include <sort/merge.hpp>
+#include <sort/quick.hpp>
+#include <time/timer.hpp>
+
+#ifndef ALG_VERSION
+#define ALG_VERSION "unknown"
+#endif
+
+namespace {
+struct Options {
+  size_t n = size_t(1) << 18;
+  size_t reps = 5;
+  uint64_t seed = 1;
+  std::string json;
+};
+
+struct Result {
+  std::string bench;
+  std::string variant;
+  double ms;
+  // time of the function pointer over this one
+  double speedup;
+};
+
+void print(Result const& r) {
+  std::printf("%-14s %-16s %10.2f %9.2fx\n", r.bench.c_str(),
+              r.variant.c_str(), r.ms, r.speedup);
+  std::fflush(stdout);
+}
+
+// keeps a result alive, so the timed work is not optimized out
+volatile int64_t sink = 0;
+
+// best of `reps` runs of `f`, in ms
+template <typename F>
+double best_ms(Options const& opt, F const& f) {
+  double best = -1;
+  for (size_t r = 0; r < opt.reps; r++) {
+    alg::Timer<HightResolutionClock> timer;
+    timer.start();
+    f();
+    timer.stop();
+    double const ms = timer.miliseconds();
+    best = best < 0 ? ms : std::min(best, ms);
+  }
+  return best;
+}
+
+std::vector<int> random_keys(Options const& opt) {
+  alg::Xoshiro256 g(opt.seed);
+  std::vector<int> keys(opt.n);
+  for (auto& k : keys) {
+    k = static_cast<int>(g() >> 33);
+  }
+  return keys;
+}
+
+// `n` puts, then `n` gets, on the table made by `make()`
+template <typename Make>
+double symbol_table(Options const& opt,
+                    std::vector<int> const& keys,
+                    Make const& make) {
+  return best_ms(opt, [&] {
+    auto st = make();
+    for (size_t i = 0; i < keys.size(); i++) {
+      st.put(keys[i], static_cast<int>(i));
+    }
+    int64_t sum = 0;
+    for (int const k : keys) {
+      sum += st.get(k).value_or(0);
+    }
+    sink = sum;
+  });
+}
+
+template <template <typename, auto> class Sorter, auto cmp>
+double sort(Options const& opt, std::vector<int64_t> const& input) {
+  return best_ms(opt, [&] {
+    std::vector<int64_t> a = input;
+    Sorter<int64_t, cmp>::sort(a);
+    sink = a[a.size() / 2];
+  });
+}
+
+constexpr auto greater_lambda = [](int64_t const& x, int64_t const& y) {
+  return x > y;
+};
+
+// `times[0]` is the function pointer
+void add(std::vector<Result>& results,
+         std::string const& bench,
+         std::vector<std::string> const& variants,
+         std::vector<double> const& times) {
+  for (size_t i = 0; i < variants.size(); i++) {
+    results.push_back({bench, variants[i], times[i], times[0] / times[i]});
+    print(results.back());
+  }
+}
+
+std::string json(Options const& opt, std::vector<Result> const& results) {
+  std::ostringstream os;
+  os.precision(6);
+  os << "{\n  \"version\": \"" << ALG_VERSION << "\",\n"
+     << "  \"seed\": " << opt.seed << ",\n"
+     << "  \"n\": " << opt.n << ",\n"
+     << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    Result const& r = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"bench\": \"" << r.bench
+       << "\", \"variant\": \"" << r.variant << "\", \"ms\": " << r.ms
+       << ", \"speedup\": " << r.speedup << "}";
+  }
+  os << "\n  ]\n}\n";
+  return os.str();
+}
+
+Options parse(int const argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; i++) {
+    std::string const arg = argv[i];
+    if (i + 1 >= argc) {
+      throw std::runtime_error("missing value of " + arg);
+    }
+    std::string const value = argv[++i];
+    if (arg == "--n") {
+      opt.n = std::stoull(value);
+    } else if (arg == "--reps") {
+      opt.reps = std::stoull(value);
+    } else if (arg == "--seed") {
+      opt.seed = std::stoull(value);
+    } else if (arg == "--json") {
+      opt.json = value;
+    } else {
+      throw std::runtime_error("unknown option " + arg);
+    }
+  }
+  if (opt.n == 0 || opt.reps == 0) {
+    throw std::runtime_error("--n and --reps must be positive");
+  }
+  return opt;
+}
+};  // namespace
+
+int main(int argc, char* argv[]) {
+  Options const opt = parse(argc, argv);
+  std::vector<Result> results;
+  std::vector<int> const keys = random_keys(opt);
+
+  std::printf("%-14s %-16s %10s %10s\n", "bench", "variant", "ms",
+              "speedup");
+  add(results, "LinearProbing", {"pointer", "function_object"},
+      {symbol_table(opt, keys,
+                    [] {
+                      return alg::LinearProbing<int, int>(
+                          alg::Hash<int>::hash);
+                    }),
+       symbol_table(opt, keys, [] {
+         return alg::LinearProbing<int, int, alg::Hasher<int>,
+                                   std::equal_to<int>>();
+       })});
+
+  auto const three_way = [](int const& x, int const& y) {
+    return x < y ? -1 : (x > y ? 1 : 0);
+  };
+  add(results, "LLRB", {"pointer", "lambda"},
+      {symbol_table(opt, keys, [] { return alg::LLRB<int, int>(); }),
+       symbol_table(opt, keys, [&] {
+         return alg::LLRB<int, int, decltype(three_way)>(three_way);
+       })});
+
+  std::vector<int64_t> input(opt.n);
+  alg::Xoshiro256 g(opt.seed + 1);
+  for (auto& x : input) {
+    x = static_cast<int64_t>(g());
+  }
+  add(results, "QuickX", {"pointer", "std_greater", "lambda"},
+      {sort<alg::QuickX, alg::Order<int64_t>::greater>(opt, input),
+       sort<alg::QuickX, std::greater<int64_t>{}>(opt, input),
+       sort<alg::QuickX, greater_lambda>(opt, input)});
+  add(results, "Merge", {"pointer", "std_greater", "lambda"},
+      {sort<alg::Merge, alg::Order<int64_t>::greater>(opt, input),
+       sort<alg::Merge, std::greater<int64_t>{}>(opt, input),
+       sort<alg::Merge, greater_lambda>(opt, input)});
+
+  if (!opt.json.empty()) {
+    FILE* f = std::fopen(opt.json.c_str(), "w");
+    if (f == nullptr) {
+      throw std::runtime_error("cannot open " + opt.json);
+    }
+    std::string const s = json(opt, results);
+    std::fwrite(s.data(), 1, s.size(), f);
+    std::fclose(f);
+  }
+  return 0;
+}
@@ -0,0 +1,450 @@
+/*
+ * sort benchmark
+ *
+ * runs the sorters of `include/sort/` over doubling sizes and several input
+ * shapes, and reports per (sorter, shape, size):
+ * 1. ns per element, the median of `--reps` timed runs
+ * 2. the doubling ratio `T(2n) / T(n)` and its log2, the exponent `b` of a
+ *    power law `T(n) ~ a n^b`
+ * 3. compares and moves (copy / move constructions and assignments, a swap
+ *    being three), counted in a separate run on a key wrapper that counts
+ *    them. the wrapper is not arithmetic, so sorting networks are not used
+ *    in that run and the counts are of the comparison-only path.
+ * results are printed as a table, and written as JSON with `--json`.
+ *
+ * usage: sort_bench [--min N] [--max N] [--reps R] [--seed S]
+ *                   [--shapes a,b,..] [--sorters a,b,..] [--threads T]
+ *                   [--quadratic-max N] [--no-counts] [--json FILE]
+ */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <random/sampling.hpp>
+#include <sort/heap.hpp>
+#include <sort/insertion.hpp>
+#include <sort/merge.hpp>
+#include <sort/quick.hpp>
+#include <sort/radix.hpp>
+#include <sort/sample.hpp>
+#include <sort/selection.hpp>
+#include <sort/shell.hpp>
+#include <sort/sort.hpp>
+#include <sort/string_sort.hpp>
+#include <time/timer.hpp>
+
+#ifndef ALG_VERSION
+#define ALG_VERSION "unknown"
+#endif
+
+namespace {
+struct Options {
+  size_t min = size_t(1) << 10;
+  size_t max = size_t(1) << 20;
+  size_t reps = 5;
+  uint64_t seed = 1;
+  std::vector<std::string> shapes = {"random",     "sorted",
+                                     "reversed",   "few_unique",
+                                     "organ_pipe", "nearly_sorted",
+                                     "zipf",       "strings"};
+  std::vector<std::string> sorters;
+  size_t threads = alg::Scheduler::default_concurrency();
+  // quadratic sorters only up to this size
+  size_t quadratic_max = size_t(1) << 14;
+  bool counts = true;
+  std::string json;
+};
+
+struct Counters {
+  static inline std::atomic<uint64_t> compares{0};
+  static inline std::atomic<uint64_t> moves{0};
+
+  static void reset() {
+    compares = 0;
+    moves = 0;
+  }
+};
+
+// key that counts its compares and moves
+template <typename K>
+struct Counted {
+  K k;
+
+  Counted() = default;
+  Counted(K key) : k(std::move(key)) {}
+  Counted(Counted const& o) : k(o.k) { count_move(); }
+  Counted(Counted&& o) noexcept : k(std::move(o.k)) { count_move(); }
+  Counted& operator=(Counted const& o) {
+    k = o.k;
+    count_move();
+    return *this;
+  }
+  Counted& operator=(Counted&& o) noexcept {
+    k = std::move(o.k);
+    count_move();
+    return *this;
+  }
+
+  friend bool operator<(Counted const& a, Counted const& b) {
+    count_compare();
+    return a.k < b.k;
+  }
+  friend bool operator>(Counted const& a, Counted const& b) {
+    count_compare();
+    return a.k > b.k;
+  }
+  friend bool operator<=(Counted const& a, Counted const& b) {
+    count_compare();
+    return a.k <= b.k;
+  }
+  friend bool operator>=(Counted const& a, Counted const& b) {
+    count_compare();
+    return a.k >= b.k;
+  }
+  friend bool operator==(Counted const& a, Counted const& b) {
+    count_compare();
+    return a.k == b.k;
+  }
+
+ private:
+  static void count_move() {
+    Counters::moves.fetch_add(1, std::memory_order_relaxed);
+  }
+  static void count_compare() {
+    Counters::compares.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+template <typename K>
+struct Sorter {
+  std::string name;
+  std::function<void(std::vector<K>&)> sort;
+  bool quadratic;
+};
+
+// every sorter applicable to keys `K`
+template <typename K>
+std::vector<Sorter<K>> sorters(alg::Scheduler& sched) {
+  using V = std::vector<K>;
+  std::vector<Sorter<K>> r = {
+      {"Selection", [](V& a) { alg::Selection<K>::sort(a); }, true},
+      {"Insertion", [](V& a) { alg::Insertion<K>::sort(a); }, true},
+      {"Shell", [](V& a) { alg::Shell<K>::sort(a); }, false},
+      {"Merge", [](V& a) { alg::Merge<K>::sort(a); }, false},
+      {"MergeBU", [](V& a) { alg::MergeBU<K>::sort(a); }, false},
+      {"NaturalMerge", [](V& a) { alg::NaturalMerge<K>::sort(a); }, false},
+      {"ParallelMerge",
+       [&sched](V& a) { alg::ParallelMerge<K>::sort(a, sched); }, false},
+      {"Quick", [](V& a) { alg::Quick<K>::sort(a); }, false},
+      {"QuickX", [](V& a) { alg::QuickX<K>::sort(a); }, false},
+      {"ParallelQuickX",
+       [&sched](V& a) { alg::ParallelQuickX<K>::sort(a, sched); }, false},
+      {"IntroQuickX", [](V& a) { alg::IntroQuickX<K>::sort(a); }, false},
+      {"Quick3Way", [](V& a) { alg::Quick3Way<K>::sort(a); }, false},
+      {"SampleSort",
+       [&sched](V& a) { alg::SampleSort<K>::sort(a, sched); }, false},
+      {"Heap", [](V& a) { alg::Heap<K>::sort(a); }, false},
+      {"alg::sort", [](V& a) { alg::sort(a); }, false},
+      {"std::sort", [](V& a) { std::sort(a.begin(), a.end()); }, false},
+      {"std::stable_sort",
+       [](V& a) { std::stable_sort(a.begin(), a.end()); }, false},
+  };
+  if constexpr (alg::RadixKey<K>) {
+    r.push_back({"LSD", [](V& a) { alg::LSD<K>::sort(a); }, false});
+  }
+  if constexpr (std::is_same_v<K, std::string>) {
+    r.push_back({"MSD", [](V& a) { alg::MSD::sort(a); }, false});
+    r.push_back(
+        {"Quick3String", [](V& a) { alg::Quick3String::sort(a); }, false});
+  }
+  return r;
+}
+
+std::vector<int> int_input(std::string const& shape,
+                           size_t const n,
+                           uint64_t const seed) {
+  std::vector<int> a(n);
+  alg::Xoshiro256 g(seed);
+  int const m = static_cast<int>(n);
+  if (shape == "random") {
+    for (auto& x : a) {
+      x = alg::uniform(g, 0, std::max(m, 1) - 1);
+    }
+  } else if (shape == "sorted") {
+    for (int i = 0; i < m; i++) {
+      a[i] = i;
+    }
+  } else if (shape == "reversed") {
+    for (int i = 0; i < m; i++) {
+      a[i] = m - i;
+    }
+  } else if (shape == "few_unique") {
+    for (auto& x : a) {
+      x = alg::uniform(g, 0, 15);
+    }
+  } else if (shape == "organ_pipe") {
+    for (int i = 0; i < m; i++) {
+      a[i] = std::min(i, m - 1 - i);
+    }
+  } else if (shape == "nearly_sorted") {
+    // sorted, then 1% of the items swapped with random others
+    for (int i = 0; i < m; i++) {
+      a[i] = i;
+    }
+    for (size_t k = 0; k < n / 100; k++) {
+      std::swap(a[alg::bounded(g, n)], a[alg::bounded(g, n)]);
+    }
+  } else if (shape == "zipf") {
+    alg::Zipf const zipf(n, 1.0);
+    for (auto& x : a) {
+      x = static_cast<int>(zipf(g));
+    }
+  } else {
+    throw std::runtime_error("unknown shape: " + shape);
+  }
+  return a;
+}
+
+// words of 1..16 lowercase letters, a quarter of them under one of a few
+// shared prefixes
+std::vector<std::string> string_input(size_t const n, uint64_t const seed) {
+  static char const* const prefixes[] = {"http://www.", "https://", "user_",
+                                         "id-000"};
+  std::vector<std::string> a(n);
+  alg::Xoshiro256 g(seed);
+  for (auto& s : a) {
+    if (alg::bounded(g, 4) == 0) {
+      s = prefixes[alg::bounded(g, 4)];
+    }
+    size_t const len = 1 + alg::bounded(g, 16);
+    for (size_t i = 0; i < len; i++) {
+      s.push_back(static_cast<char>('a' + alg::bounded(g, 26)));
+    }
+  }
+  return a;
+}
+
+struct Result {
+  std::string sorter, shape;
+  size_t n;
+  double ns_per_element;
+  std::optional<double> doubling_ratio;
+  std::optional<uint64_t> compares, moves;
+};
+
+void print(Result const& r) {
+  std::printf("%-16s %-14s %10zu %12.2f", r.sorter.c_str(), r.shape.c_str(),
+              r.n, r.ns_per_element);
+  if (r.doubling_ratio) {
+    std::printf(" %7.2f %6.2f", *r.doubling_ratio,
+                std::log2(*r.doubling_ratio));
+  } else {
+    std::printf(" %7s %6s", "-", "-");
+  }
+  if (r.compares) {
+    std::printf(" %14llu %14llu",
+                static_cast<unsigned long long>(*r.compares),
+                static_cast<unsigned long long>(*r.moves));
+  } else {
+    std::printf(" %14s %14s", "-", "-");
+  }
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+template <typename K>
+bool is_sorted_input(std::vector<K> const& a) {
+  return std::is_sorted(a.begin(), a.end());
+}
+
+template <typename K>
+void run_shape(Options const& opt,
+               alg::Scheduler& sched,
+               std::string const& shape,
+               std::function<std::vector<K>(size_t)> const& make,
+               std::vector<Result>& results) {
+  auto const timed = sorters<K>(sched);
+  std::vector<Sorter<Counted<K>>> counted;
+  if (opt.counts) {
+    counted = sorters<Counted<K>>(sched);
+  }
+  for (auto const& s : timed) {
+    if (!opt.sorters.empty() &&
+        std::find(opt.sorters.begin(), opt.sorters.end(), s.name) ==
+            opt.sorters.end()) {
+      continue;
+    }
+    std::optional<double> prev;
+    size_t prev_n = 0;
+    for (size_t n = opt.min; n <= opt.max; n *= 2) {
+      if (s.quadratic && n > opt.quadratic_max) {
+        break;
+      }
+      std::vector<K> const input = make(n);
+      std::vector<double> times;
+      alg::Timer<HightResolutionClock> timer;
+      for (size_t r = 0; r < opt.reps; r++) {
+        std::vector<K> a = input;
+        timer.reset();
+        timer.start();
+        s.sort(a);
+        timer.stop();
+        if (!is_sorted_input(a)) {
+          throw std::runtime_error(s.name + " failed on " + shape);
+        }
+        times.push_back(timer.seconds());
+      }
+      std::nth_element(times.begin(), times.begin() + times.size() / 2,
+                       times.end());
+      double const t = times[times.size() / 2];
+
+      Result res{s.name, shape, n, 1e9 * t / static_cast<double>(n), {},
+                 {},     {}};
+      if (prev && prev_n * 2 == n && *prev > 0) {
+        res.doubling_ratio = t / *prev;
+      }
+      auto const c = std::find_if(counted.begin(), counted.end(),
+                                  [&](auto const& x) {
+                                    return x.name == s.name;
+                                  });
+      if (c != counted.end()) {
+        std::vector<Counted<K>> a(input.begin(), input.end());
+        Counters::reset();
+        c->sort(a);
+        res.compares = Counters::compares.load();
+        res.moves = Counters::moves.load();
+      }
+      results.push_back(res);
+      print(res);
+      prev = t;
+      prev_n = n;
+    }
+  }
+}
+
+std::string json(Options const& opt, std::vector<Result> const& results) {
+  std::ostringstream os;
+  os.precision(6);
+  os << "{\n  \"version\": \"" << ALG_VERSION << "\",\n"
+     << "  \"seed\": " << opt.seed << ",\n"
+     << "  \"reps\": " << opt.reps << ",\n"
+     << "  \"threads\": " << opt.threads << ",\n"
+     << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    Result const& r = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"sorter\": \"" << r.sorter
+       << "\", \"shape\": \"" << r.shape << "\", \"n\": " << r.n
+       << ", \"ns_per_element\": " << r.ns_per_element
+       << ", \"doubling_ratio\": ";
+    if (r.doubling_ratio) {
+      os << *r.doubling_ratio;
+    } else {
+      os << "null";
+    }
+    os << ", \"compares\": ";
+    if (r.compares) {
+      os << *r.compares << ", \"moves\": " << *r.moves;
+    } else {
+      os << "null, \"moves\": null";
+    }
+    os << "}";
+  }
+  os << "\n  ]\n}\n";
+  return os.str();
+}
+
+std::vector<std::string> split(std::string const& s) {
+  std::vector<std::string> r;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      r.push_back(item);
+    }
+  }
+  return r;
+}
+
+Options parse(int const argc, char* argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; i++) {
+    std::string const arg = argv[i];
+    if (arg == "--no-counts") {
+      opt.counts = false;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      throw std::runtime_error("missing value of " + arg);
+    }
+    std::string const value = argv[++i];
+    if (arg == "--min") {
+      opt.min = std::stoull(value);
+    } else if (arg == "--max") {
+      opt.max = std::stoull(value);
+    } else if (arg == "--reps") {
+      opt.reps = std::stoull(value);
+    } else if (arg == "--seed") {
+      opt.seed = std::stoull(value);
+    } else if (arg == "--shapes") {
+      opt.shapes = split(value);
+    } else if (arg == "--sorters") {
+      opt.sorters = split(value);
+    } else if (arg == "--threads") {
+      opt.threads = std::stoull(value);
+    } else if (arg == "--quadratic-max") {
+      opt.quadratic_max = std::stoull(value);
+    } else if (arg == "--json") {
+      opt.json = value;
+    } else {
+      throw std::runtime_error("unknown option " + arg);
+    }
+  }
+  if (opt.min == 0 || opt.reps == 0 || opt.threads == 0) {
+    throw std::runtime_error("--min, --reps and --threads must be positive");
+  }
+  return opt;
+}
+};  // namespace
+
+int main(int argc, char* argv[]) {
+  Options const opt = parse(argc, argv);
+  alg::Scheduler sched(opt.threads);
+  std::vector<Result> results;
+
+  std::printf("%-16s %-14s %10s %12s %7s %6s %14s %14s\n", "sorter", "shape",
+              "n", "ns/element", "T2n/Tn", "log2", "compares", "moves");
+  for (std::string const& shape : opt.shapes) {
+    if (shape == "strings") {
+      run_shape<std::string>(
+          opt, sched, shape,
+          [&](size_t const n) { return string_input(n, opt.seed); }, results);
+    } else {
+      run_shape<int>(
+          opt, sched, shape,
+          [&](size_t const n) { return int_input(shape, n, opt.seed); },
+          results);
+    }
+  }
+
+  if (!opt.json.empty()) {
+    FILE* f = std::fopen(opt.json.c_str(), "w");
+    if (f == nullptr) {
+      throw std::runtime_error("cannot open " + opt.json);
+    }
+    std::string const s = json(opt, results);
+    std::fwrite(s.data(), 1, s.size(), f);
+    std::fclose(f);
+  }
+  return 0;
+}
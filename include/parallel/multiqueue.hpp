@@ -0,0 +1,157 @@
+#ifndef __ALG_PARALLEL_MULTIQUEUE_HPP__
+#define __ALG_PARALLEL_MULTIQUEUE_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <sort/common.hpp>
+#include <sort/heap.hpp>
+
+namespace alg {
+/*
+ * MultiQueue (Rihani, Sanders and Dementiev)
+ * relaxed concurrent priority queue: `c * p` sequential heaps for `p`
+ * threads, each behind its own try-lock.
+ * 1. `push` locks a random heap and pushes there
+ * 2. `pop` locks two random heaps and pops the lesser of their tops
+ * a lock already held is never waited for, another heap is drawn instead,
+ * so threads seldom meet on a cache line. the popped item is not always the
+ * least one queued, but its rank is `O(c * p)` in expectation: with two
+ * choices, the tops of the heaps stay close to each other.
+ *
+ * `try_pop` only gives up once no item is left, counting those still being
+ * pushed.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class MultiQueue {
+  // a heap per cache line, so that two locks never share one
+  struct alignas(64) Lane {
+    std::atomic<bool> locked_{false};
+    DaryHeap<T, cmp> heap_;
+
+    bool try_lock() {
+      return !locked_.load(std::memory_order_relaxed) &&
+             !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() { locked_.store(false, std::memory_order_release); }
+  };
+
+  std::unique_ptr<Lane[]> lanes_;
+  size_t n_lanes_;
+  std::atomic<size_t> size_{0};
+
+ public:
+  // `c` heaps per thread, for `n_threads` threads
+  explicit MultiQueue(
+      size_t const n_threads = Scheduler::default_concurrency(),
+      size_t const c = 2)
+      : n_lanes_{n_threads * c < 2 ? 2 : n_threads * c} {
+    lanes_ = std::make_unique<Lane[]>(n_lanes_);
+  }
+
+  MultiQueue(MultiQueue const&) = delete;
+  MultiQueue& operator=(MultiQueue const&) = delete;
+
+  size_t lanes() const { return n_lanes_; }
+
+  // exact when no push or pop is running
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  bool empty() const { return size() == 0; }
+
+  void push(T x) {
+    // counted first, so that `size` never drops below the items queued
+    size_.fetch_add(1, std::memory_order_relaxed);
+    DefaultRng& g = thread_rng();
+    while (true) {
+      Lane& l = lanes_[bounded(g, n_lanes_)];
+      if (l.try_lock()) {
+        l.heap_.push(std::move(x));
+        l.unlock();
+        return;
+      }
+    }
+  }
+
+  // a near least item, or nothing if every heap was found empty
+  std::optional<T> try_pop() {
+    DefaultRng& g = thread_rng();
+    // two choices while items are left; on empty heaps, fall back to a sweep
+    while (size() > 0) {
+      size_t const i = bounded(g, n_lanes_);
+      size_t j = bounded(g, n_lanes_ - 1);
+      j += j >= i;
+      Lane& a = lanes_[i];
+      if (!a.try_lock()) {
+        continue;
+      }
+      Lane& b = lanes_[j];
+      if (!b.try_lock()) {
+        a.unlock();
+        continue;
+      }
+      Lane* best = &a;
+      if (a.heap_.empty() ||
+          (!b.heap_.empty() && cmp(b.heap_.top(), a.heap_.top()))) {
+        best = &b;
+      }
+      std::optional<T> r;
+      if (!best->heap_.empty()) {
+        r.emplace(best->heap_.pop());
+      }
+      a.unlock();
+      b.unlock();
+      if (r) {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return r;
+      }
+      if (std::optional<T> s = sweep(i)) {
+        return s;
+      }
+    }
+    return std::nullopt;
+  }
+
+  T pop() {
+    std::optional<T> r = try_pop();
+    if (!r) {
+      throw std::runtime_error("error popping: MultiQueue is empty");
+    }
+    return std::move(*r);
+  }
+
+ private:
+  // pop from the first non-empty heap from `start` on, waiting for each lock
+  std::optional<T> sweep(size_t const start) {
+    for (size_t k = 0; k < n_lanes_; k++) {
+      Lane& l = lanes_[(start + k) % n_lanes_];
+      while (!l.try_lock()) {
+        std::this_thread::yield();
+      }
+      std::optional<T> r;
+      if (!l.heap_.empty()) {
+        r.emplace(l.heap_.pop());
+      }
+      l.unlock();
+      if (r) {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return r;
+      }
+    }
+    return std::nullopt;
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_PARALLEL_MULTIQUEUE_HPP__
@@ -0,0 +1,235 @@
+#ifndef __ALG_PARALLEL_SCHEDULER_HPP__
+#define __ALG_PARALLEL_SCHEDULER_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace alg {
+/*
+ * work-stealing scheduler
+ *
+ * Each worker owns a deque. Tasks forked by a worker are pushed to and popped
+ * from the back of its own deque (LIFO, data still in cache), while idle
+ * workers steal from the front of other deques (FIFO, the oldest task is
+ * usually the biggest piece of work). Threads outside the pool submit to one
+ * extra shared deque.
+ *
+ * The calling thread is counted as a worker: a thread waiting on a
+ * `TaskGroup` keeps running pending tasks instead of blocking, so nested
+ * fork-join never deadlocks, and a scheduler without any worker thread simply
+ * runs everything on the caller.
+ */
+class Scheduler {
+  using Task = std::function<void()>;
+
+  struct Queue {
+    std::mutex mu_;
+    std::deque<Task> tasks_;
+  };
+
+  std::vector<std::thread> workers_;
+  // `queues_[i]` for worker `i`, the last one shared by outside threads
+  std::vector<std::unique_ptr<Queue>> queues_;
+  // number of queued (not yet started) tasks
+  std::atomic<size_t> n_queued_;
+  std::atomic<bool> stop_;
+  std::mutex sleep_mu_;
+  std::condition_variable sleep_cv_;
+
+  // scheduler owning the current thread, and its worker index
+  inline static thread_local Scheduler* owner_ = nullptr;
+  inline static thread_local size_t index_ = 0;
+
+ public:
+  // `n_threads` threads in total, the caller included
+  explicit Scheduler(size_t const n_threads = default_concurrency())
+      : n_queued_{0}, stop_{false} {
+    size_t const n_workers = n_threads > 1 ? n_threads - 1 : 0;
+    for (size_t i = 0; i <= n_workers; i++) {
+      queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(n_workers);
+    for (size_t i = 0; i < n_workers; i++) {
+      workers_.emplace_back([this, i] { work(i); });
+    }
+  }
+
+  Scheduler(Scheduler const&) = delete;
+  Scheduler& operator=(Scheduler const&) = delete;
+
+  ~Scheduler() {
+    {
+      std::lock_guard<std::mutex> lk(sleep_mu_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& w : workers_) {
+      w.join();
+    }
+  }
+
+  // process-wide scheduler using all hardware threads
+  static Scheduler& instance() {
+    static Scheduler sched;
+    return sched;
+  }
+
+  static size_t default_concurrency() {
+    size_t const n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+  }
+
+  // number of threads executing tasks, the caller included
+  size_t concurrency() const { return workers_.size() + 1; }
+
+  void submit(Task task) {
+    Queue& q = owner_ == this ? *queues_[index_] : *queues_.back();
+    {
+      std::lock_guard<std::mutex> lk(q.mu_);
+      q.tasks_.push_back(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> lk(sleep_mu_);
+      n_queued_++;
+    }
+    sleep_cv_.notify_one();
+  }
+
+  // run one pending task if there is any
+  bool run_one() {
+    Task task;
+    if (!take(task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+ private:
+  void work(size_t const i) {
+    owner_ = this;
+    index_ = i;
+    while (true) {
+      if (run_one()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lk(sleep_mu_);
+      sleep_cv_.wait(lk, [this] { return stop_ || n_queued_ > 0; });
+      if (stop_ && n_queued_ == 0) {
+        return;
+      }
+    }
+  }
+
+  bool take(Task& task) {
+    size_t const n = queues_.size();
+    size_t const own = owner_ == this ? index_ : n - 1;
+    {
+      // own deque first, from the back, so that a waiting thread runs its
+      // own children before anything else and the stack stays shallow
+      Queue& q = *queues_[own];
+      std::lock_guard<std::mutex> lk(q.mu_);
+      if (!q.tasks_.empty()) {
+        task = std::move(q.tasks_.back());
+        q.tasks_.pop_back();
+        n_queued_--;
+        return true;
+      }
+    }
+    // steal from the front of the others
+    size_t const start = victim_seed();
+    for (size_t k = 1; k < n; k++) {
+      Queue& q = *queues_[(own + start + k) % n];
+      std::lock_guard<std::mutex> lk(q.mu_);
+      if (!q.tasks_.empty()) {
+        task = std::move(q.tasks_.front());
+        q.tasks_.pop_front();
+        n_queued_--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // cheap per-thread xorshift to spread thieves over the victims
+  static size_t victim_seed() {
+    thread_local uint64_t x =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return static_cast<size_t>(x);
+  }
+};
+
+/*
+ * fork-join group of tasks
+ *
+ * `run` forks a task onto the scheduler, `wait` joins all of them, helping to
+ * run pending tasks meanwhile. The first exception thrown by a task is
+ * rethrown from `wait`.
+ */
+class TaskGroup {
+  Scheduler& sched_;
+  std::atomic<size_t> pending_;
+  std::mutex error_mu_;
+  std::exception_ptr error_;
+
+ public:
+  explicit TaskGroup(Scheduler& sched = Scheduler::instance())
+      : sched_{sched}, pending_{0}, error_{nullptr} {}
+
+  TaskGroup(TaskGroup const&) = delete;
+  TaskGroup& operator=(TaskGroup const&) = delete;
+
+  ~TaskGroup() { join(); }
+
+  Scheduler& scheduler() { return sched_; }
+
+  template <typename F>
+  void run(F&& f) {
+    pending_++;
+    sched_.submit([this, f = std::forward<F>(f)]() mutable {
+      try {
+        f();
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(error_mu_);
+        if (error_ == nullptr) {
+          error_ = std::current_exception();
+        }
+      }
+      pending_--;
+    });
+  }
+
+  void wait() {
+    join();
+    if (error_ != nullptr) {
+      std::exception_ptr e = nullptr;
+      std::swap(e, error_);
+      std::rethrow_exception(e);
+    }
+  }
+
+ private:
+  void join() {
+    while (pending_ > 0) {
+      if (!sched_.run_one()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_PARALLEL_SCHEDULER_HPP__
@@ -0,0 +1,246 @@
+#ifndef __ALG_RANDOM_PRNG_HPP__
+#define __ALG_RANDOM_PRNG_HPP__
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+namespace alg {
+// GCC and Clang extension, for 64x64 -> 128 bit products
+__extension__ typedef unsigned __int128 Uint128;
+
+/*
+ * small-state pseudo random generators, all of them
+ * `std::uniform_random_bit_generator`s of 64-bit words, so they also plug
+ * into `std::shuffle` and the distributions of `<random>`.
+ *
+ * none of them is fit for cryptography. each is a few instructions per word,
+ * against a 5 KB state and a refill every 624 words for `std::mt19937`.
+ */
+
+/*
+ * SplitMix64 (Steele, Lea and Flood)
+ * a Weyl sequence through a 64-bit finalizer. used to expand a single seed
+ * into the state of the other generators: close seeds give unrelated states.
+ */
+class SplitMix64 {
+  uint64_t s_;
+
+ public:
+  using result_type = uint64_t;
+
+  explicit SplitMix64(uint64_t const seed = 0) : s_{seed} {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    uint64_t z = (s_ += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+};
+
+/*
+ * xoshiro256** (Blackman and Vigna)
+ * 256 bits of state, period `2^256 - 1`. `jump` advances it by `2^128` words,
+ * which splits one seed into non-overlapping streams for parallel tasks.
+ */
+class Xoshiro256 {
+  uint64_t s_[4];
+
+ public:
+  using result_type = uint64_t;
+
+  explicit Xoshiro256(uint64_t const seed = 0) {
+    SplitMix64 sm(seed);
+    for (auto& s : s_) {
+      s = sm();
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    uint64_t const r = std::rotl(s_[1] * 5, 7) * 9;
+    uint64_t const t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = std::rotl(s_[3], 45);
+    return r;
+  }
+
+  void jump() {
+    static constexpr uint64_t JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                                        0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (uint64_t const j : JUMP) {
+      for (int b = 0; b < 64; b++) {
+        if (j & (uint64_t(1) << b)) {
+          for (int k = 0; k < 4; k++) {
+            t[k] ^= s_[k];
+          }
+        }
+        (*this)();
+      }
+    }
+    for (int k = 0; k < 4; k++) {
+      s_[k] = t[k];
+    }
+  }
+};
+
+/*
+ * PCG64 (O'Neill), the XSL RR 128/64 variant
+ * a 128-bit linear congruential state, output by xoring its halves and a
+ * rotation chosen by the top bits. `stream` picks one of `2^127` independent
+ * sequences.
+ */
+class Pcg64 {
+  static constexpr Uint128 MULTIPLIER =
+      (Uint128(0x2360ed051fc65da4) << 64) | 0x4385df649fccf645;
+
+  Uint128 s_;
+  Uint128 inc_;
+
+ public:
+  using result_type = uint64_t;
+
+  explicit Pcg64(uint64_t const seed = 0, uint64_t const stream = 0)
+      : s_{0}, inc_{(Uint128(stream) << 1) | 1} {
+    SplitMix64 sm(seed);
+    (*this)();
+    s_ += (Uint128(sm()) << 64) | sm();
+    (*this)();
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    s_ = s_ * MULTIPLIER + inc_;
+    uint64_t const x =
+        static_cast<uint64_t>(s_ >> 64) ^ static_cast<uint64_t>(s_);
+    return std::rotr(x, static_cast<int>(s_ >> 122));
+  }
+};
+
+/*
+ * wyrand (Wang Yi)
+ * a Weyl sequence through one 64x64 -> 128 bit multiply: the fastest here,
+ * a single word of state, period `2^64`.
+ */
+class Wyrand {
+  uint64_t s_;
+
+ public:
+  using result_type = uint64_t;
+
+  explicit Wyrand(uint64_t const seed = 0) : s_{seed} {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    s_ += 0xa0761d6478bd642f;
+    Uint128 const t = static_cast<Uint128>(s_) * (s_ ^ 0xe7037ed1a0b428db);
+    return static_cast<uint64_t>(t >> 64) ^ static_cast<uint64_t>(t);
+  }
+};
+
+// generators of uniform 64-bit words, all values possible
+template <typename G>
+concept Rng64 = std::uniform_random_bit_generator<G> &&
+                std::same_as<typename G::result_type, uint64_t> &&
+                (G::min() == 0) &&
+                (G::max() == std::numeric_limits<uint64_t>::max());
+
+/*
+ * uniform integer in `[0, n)`, `n > 0`, by Lemire's multiply-shift: the high
+ * word of `x * n` for a random word `x`. the low word tells the few draws
+ * that would bias the result, which are redrawn, and the division computing
+ * that threshold only runs when the low word is below `n`, a chance of
+ * `n / 2^64`. ranges below `2^32` take the upper half of a word and a 64-bit
+ * product instead.
+ */
+template <Rng64 G>
+uint64_t bounded(G& g, uint64_t const n) {
+  if (n < (uint64_t(1) << 32)) {
+    uint32_t const n32 = static_cast<uint32_t>(n);
+    uint64_t m = (g() >> 32) * n32;
+    uint32_t l = static_cast<uint32_t>(m);
+    if (l < n32) {
+      // `2^32 mod n`
+      uint32_t const t = (0u - n32) % n32;
+      while (l < t) {
+        m = (g() >> 32) * n32;
+        l = static_cast<uint32_t>(m);
+      }
+    }
+    return m >> 32;
+  }
+  Uint128 m = static_cast<Uint128>(g()) * n;
+  uint64_t l = static_cast<uint64_t>(m);
+  if (l < n) {
+    // `2^64 mod n`
+    uint64_t const t = (0 - n) % n;
+    while (l < t) {
+      m = static_cast<Uint128>(g()) * n;
+      l = static_cast<uint64_t>(m);
+    }
+  }
+  return static_cast<uint64_t>(m >> 64);
+}
+
+// uniform integer in `[lo, hi]`
+template <std::integral T, Rng64 G>
+T uniform(G& g, T const lo, T const hi) {
+  using U = std::make_unsigned_t<T>;
+  uint64_t const span =
+      static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo));
+  uint64_t const r =
+      span == std::numeric_limits<uint64_t>::max() ? g() : bounded(g, span + 1);
+  return static_cast<T>(static_cast<U>(static_cast<U>(lo) + r));
+}
+
+// uniform double in `[0, 1)`, the 53 upper bits of a word
+template <Rng64 G>
+double unit(G& g) {
+  return static_cast<double>(g() >> 11) * 0x1.0p-53;
+}
+
+using DefaultRng = Xoshiro256;
+
+/*
+ * generator of the calling thread, seeded from `std::random_device` on first
+ * use. distinct threads never share one, so no locking is needed.
+ */
+inline DefaultRng& thread_rng() {
+  thread_local DefaultRng rng(std::random_device{}() ^
+                              (uint64_t(std::random_device{}()) << 32));
+  return rng;
+}
+
+// reseed the generator of the calling thread, for reproducible runs
+inline void seed_thread_rng(uint64_t const seed) {
+  thread_rng() = DefaultRng(seed);
+}
+};  // namespace alg
+
+#endif  // !__ALG_RANDOM_PRNG_HPP__
@@ -1,55 +1,162 @@
 #ifndef __ALG_RANDONM_RANDOM__
 #define __ALG_RANDONM_RANDOM__
 
+#include <algorithm>
+#include <concepts>
 #include <cstdint>
-#include <random>
+#include <utility>
 #include <vector>
 
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+
 namespace alg {
 template <typename T>
 class Random {
+  using Vector = std::vector<T>;
+
  public:
   /*
    * Knuth shuffle
    *
    * In iteration `i`, pick integer `r` in `[0, i]` uniformly at random.
    * Then swap `a[i]` and `a[r]`.
-   * Ref:
-   * https://stackoverflow.com/questions/288739/generate-random-numbers-uniformly-over-an-entire-range
    *
-   * Another way is to use `std::shuffle` as follows:
-   * `std::shuffle(begin, end, generator)`
+   * `r` comes from the generator of the calling thread through `bounded`,
+   * with no division in the common case; pass a seeded generator for a
+   * reproducible order.
    */
-  static void shuffle(std::vector<T>& a) {
-    std::random_device rand_dev;
-    std::mt19937 generator(rand_dev());
-    for (size_t i = 0; i < a.size(); i++) {
-      // uniform distribution on closed interval
-      // https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
-      std::uniform_int_distribution<uint64_t> distr(0, i);
-      size_t const r = distr(generator);
+  static void shuffle(Vector& a) { shuffle(a, thread_rng()); }
+
+  template <Rng64 G>
+  static void shuffle(Vector& a, G& g) {
+    for (size_t i = 1; i < a.size(); i++) {
+      size_t const r = bounded(g, i + 1);
       std::swap(a[i], a[r]);
     }
   }
+
+  /*
+   * parallel shuffle (Sanders' random scatter), for arrays large enough that
+   * the random accesses of a Knuth shuffle miss the cache on every swap.
+   *
+   * the array is cut into `k` blocks, and `k` buckets are filled:
+   * 1. each block draws a uniform bucket for each of its items and counts
+   * 2. prefix sums of the counts, bucket-major, give each block a private
+   *    range of every bucket
+   * 3. each block draws the same buckets again and moves its items there
+   * 4. each bucket is shuffled back into place by the inside-out shuffle
+   * every step runs block by block, or bucket by bucket, in parallel. the
+   * permutation is uniform: bucket sizes are multinomial, and each bucket
+   * then gets a uniform order of its items.
+   *
+   * the result depends on `seed` and the length only, not on the number of
+   * threads. `n` extra items of memory.
+   */
+  static void parallel_shuffle(Vector& a,
+                               Scheduler& sched = Scheduler::instance()) {
+    parallel_shuffle(a, thread_rng()(), sched);
+  }
+
+  static void parallel_shuffle(Vector& a,
+                               uint64_t const seed,
+                               Scheduler& sched = Scheduler::instance()) {
+    size_t const n = a.size();
+    size_t const k = std::min(MAX_BLOCKS, n / BLOCK);
+    if (k < 2) {
+      Xoshiro256 g(seed);
+      shuffle(a, g);
+      return;
+    }
+    // a stream per block for steps 1 and 3, and per bucket for step 4
+    std::vector<Xoshiro256> streams;
+    streams.reserve(2 * k);
+    SplitMix64 sm(seed);
+    for (size_t i = 0; i < 2 * k; i++) {
+      streams.emplace_back(sm());
+    }
+    auto const begin = [n, k](size_t const b) { return b * n / k; };
+
+    // count[b * k + j]: items of block `b` drawn to bucket `j`
+    std::vector<size_t> count(k * k, 0);
+    for_each_block(k, sched, [&](size_t const b) {
+      Xoshiro256 g = streams[b];
+      for (size_t i = begin(b); i < begin(b + 1); i++) {
+        count[b * k + bounded(g, k)]++;
+      }
+    });
+    std::vector<size_t> bucket(k + 1, 0);
+    size_t sum = 0;
+    for (size_t j = 0; j < k; j++) {
+      bucket[j] = sum;
+      for (size_t b = 0; b < k; b++) {
+        size_t const c = count[b * k + j];
+        count[b * k + j] = sum;
+        sum += c;
+      }
+    }
+    bucket[k] = n;
+
+    Vector aux(n);
+    for_each_block(k, sched, [&](size_t const b) {
+      Xoshiro256 g = streams[b];
+      size_t* const next = count.data() + b * k;
+      for (size_t i = begin(b); i < begin(b + 1); i++) {
+        aux[next[bounded(g, k)]++] = std::move(a[i]);
+      }
+    });
+    for_each_block(k, sched, [&](size_t const j) {
+      Xoshiro256& g = streams[k + j];
+      size_t const lo = bucket[j];
+      for (size_t i = lo; i < bucket[j + 1]; i++) {
+        size_t const r = lo + bounded(g, i - lo + 1);
+        if (r != i) {
+          a[i] = std::move(a[r]);
+        }
+        a[r] = std::move(aux[i]);
+      }
+    });
+  }
+
+ private:
+  // least items per block of a parallel shuffle, and most blocks: `k * k`
+  // counters are kept
+  static constexpr size_t BLOCK = 1 << 16;
+  static constexpr size_t MAX_BLOCKS = 256;
+
+  template <typename F>
+  static void for_each_block(size_t const k, Scheduler& sched, F const& f) {
+    TaskGroup tg(sched);
+    for (size_t b = 0; b < k; b++) {
+      tg.run([&f, b] { f(b); });
+    }
+    tg.wait();
+  }
 };
 
 /*
- * type has to be supported by `uniform_int_distribution`
- * https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
+ * uniform integers in `[lo, hi]`, drawn from a `Xoshiro256` seeded from
+ * `std::random_device`, or from `seed` for a reproducible sequence
  */
-template <typename T = int>
+template <std::integral T = int>
 class RandIntGen {
-  std::random_device rand_dev_;
-  std::mt19937 generator_;
-  std::uniform_int_distribution<T> distr_;
+  Xoshiro256 generator_;
+  T lo_, hi_;
 
  public:
   RandIntGen(T const lo, T const hi)
-      : generator_(rand_dev_()), distr_(lo, hi) {}
+      : RandIntGen(lo, hi, std::random_device{}() ^
+                               (uint64_t(std::random_device{}()) << 32)) {}
 
-  T gen() { return distr_(generator_); }
+  RandIntGen(T const lo, T const hi, uint64_t const seed)
+      : generator_(seed), lo_{lo}, hi_{hi} {}
 
-  void rest(T const lo, T const hi) { distr_(lo, hi); }
+  T gen() { return uniform(generator_, lo_, hi_); }
+
+  void rest(T const lo, T const hi) {
+    lo_ = lo;
+    hi_ = hi;
+  }
 };
 };      // namespace alg
 #endif  // !__ALG_RANDONM_RANDOM__
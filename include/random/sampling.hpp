@@ -0,0 +1,313 @@
+#ifndef __ALG_RANDOM_SAMPLING_HPP__
+#define __ALG_RANDOM_SAMPLING_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+
+namespace alg {
+/*
+ * reservoir sampling, Algorithm L (Li)
+ * keeps a uniform sample of `k` items of a stream of unknown length. rather
+ * than a draw per item, the number of items to skip before the next one
+ * enters the sample is drawn at once: a geometric gap whose success rate
+ * `w` shrinks as the stream grows. `O(k (1 + log(n / k)))` draws for `n`
+ * items; a range of random access iterators is skipped over without even
+ * looking at the items in between.
+ */
+template <typename T, Rng64 G = DefaultRng>
+class Reservoir {
+  using Vector = std::vector<T>;
+
+  size_t k_;
+  Vector items_;
+  G g_;
+  // items pushed so far, and the position of the next one to take
+  uint64_t seen_ = 0;
+  uint64_t next_ = 0;
+  double w_ = 1.0;
+
+ public:
+  explicit Reservoir(size_t const k) : Reservoir(k, G(thread_rng()())) {}
+
+  Reservoir(size_t const k, G g) : k_{k}, g_{std::move(g)} {
+    items_.reserve(k);
+  }
+
+  void push(T const& x) {
+    if (items_.size() < k_) {
+      items_.push_back(x);
+      if (++seen_ == k_) {
+        advance();
+      }
+    } else if (seen_++ == next_ && k_ > 0) {
+      items_[bounded(g_, k_)] = x;
+      advance();
+    }
+  }
+
+  template <std::input_iterator It>
+  void push(It first, It const last) {
+    for (; first != last && items_.size() < k_; ++first) {
+      push(*first);
+    }
+    if constexpr (std::random_access_iterator<It>) {
+      while (first != last && k_ > 0) {
+        uint64_t const gap = next_ - seen_;
+        uint64_t const left = static_cast<uint64_t>(last - first);
+        if (gap >= left) {
+          seen_ += left;
+          return;
+        }
+        first += gap;
+        seen_ += gap;
+        push(*first++);
+      }
+    }
+    for (; first != last; ++first) {
+      push(*first);
+    }
+  }
+
+  // items pushed so far
+  uint64_t seen() const { return seen_; }
+
+  // the sample, in no particular order
+  Vector const& items() const { return items_; }
+
+ private:
+  // draw the position of the next item to take
+  void advance() {
+    w_ *= std::exp(std::log(1.0 - unit(g_)) / static_cast<double>(k_));
+    double const gap =
+        std::floor(std::log(1.0 - unit(g_)) / std::log1p(-w_));
+    next_ = gap < static_cast<double>(std::numeric_limits<uint64_t>::max() -
+                                      seen_)
+                ? seen_ + static_cast<uint64_t>(gap)
+                : std::numeric_limits<uint64_t>::max();
+  }
+};
+
+/*
+ * alias table (Vose)
+ * `O(n)` to build from `n` weights, then `O(1)` per weighted draw: a uniform
+ * column, and a biased coin between the column itself and its alias. each
+ * column holds probability `1 / n`, part of it lent to a single heavier one.
+ */
+class AliasTable {
+  // chance of keeping column `i` rather than going to `alias_[i]`
+  std::vector<double> prob_;
+  std::vector<size_t> alias_;
+
+ public:
+  explicit AliasTable(std::vector<double> const& weights)
+      : prob_(weights.size()), alias_(weights.size()) {
+    size_t const n = weights.size();
+    double sum = 0;
+    for (double const w : weights) {
+      if (!(w >= 0) || !std::isfinite(w)) {
+        throw std::runtime_error("AliasTable error: invalid weight");
+      }
+      sum += w;
+    }
+    if (!(sum > 0)) {
+      throw std::runtime_error("AliasTable error: no positive weight");
+    }
+    // weights scaled to a mean of 1, split into columns below and above it
+    std::vector<double> p(n);
+    std::vector<size_t> small, large;
+    for (size_t i = 0; i < n; i++) {
+      p[i] = weights[i] * static_cast<double>(n) / sum;
+      (p[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      size_t const s = small.back(), l = large.back();
+      small.pop_back();
+      prob_[s] = p[s];
+      alias_[s] = l;
+      p[l] = (p[l] + p[s]) - 1.0;
+      if (p[l] < 1.0) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // left over, up to rounding: full columns
+    for (size_t const i : small) {
+      prob_[i] = 1.0;
+      alias_[i] = i;
+    }
+    for (size_t const i : large) {
+      prob_[i] = 1.0;
+      alias_[i] = i;
+    }
+  }
+
+  size_t size() const { return prob_.size(); }
+
+  // index `i` drawn with probability `weights[i] / sum`
+  template <Rng64 G>
+  size_t operator()(G& g) const {
+    size_t const i = bounded(g, prob_.size());
+    return unit(g) < prob_[i] ? i : alias_[i];
+  }
+};
+
+/*
+ * Zipf distribution over `1..n`: `k` drawn with probability proportional to
+ * `1 / k^s`, `s > 0`. rejection-inversion (Hörmann and Derflinger): inverts
+ * the integral of the continuous density, then accepts or rejects with a
+ * test that almost always passes. `O(1)` per draw and no table, whatever
+ * `n`.
+ */
+class Zipf {
+  uint64_t n_;
+  double s_;
+  double h_x1_, h_n_, threshold_;
+
+ public:
+  Zipf(uint64_t const n, double const s) : n_{n}, s_{s} {
+    if (n == 0 || !(s > 0)) {
+      throw std::runtime_error("Zipf error: need n > 0 and exponent > 0");
+    }
+    h_x1_ = h_integral(1.5) - 1.0;
+    h_n_ = h_integral(static_cast<double>(n) + 0.5);
+    threshold_ = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+  }
+
+  template <Rng64 G>
+  uint64_t operator()(G& g) const {
+    while (true) {
+      double const u = h_n_ + unit(g) * (h_x1_ - h_n_);
+      double const x = h_integral_inverse(u);
+      double const r = std::floor(x + 0.5);
+      uint64_t const k = r < 1.0 ? 1
+                         : r > static_cast<double>(n_)
+                             ? n_
+                             : static_cast<uint64_t>(r);
+      double const kd = static_cast<double>(k);
+      if (kd - x <= threshold_ || u >= h_integral(kd + 0.5) - h(kd)) {
+        return k;
+      }
+    }
+  }
+
+ private:
+  // the density `x^-s`
+  double h(double const x) const { return std::exp(-s_ * std::log(x)); }
+
+  // its integral from 1, `(x^(1-s) - 1) / (1 - s)`, `log x` for `s = 1`
+  double h_integral(double const x) const {
+    double const log_x = std::log(x);
+    return expm1_ratio((1.0 - s_) * log_x) * log_x;
+  }
+
+  double h_integral_inverse(double const y) const {
+    double t = y * (1.0 - s_);
+    if (t < -1.0) {
+      t = -1.0;
+    }
+    return std::exp(log1p_ratio(t) * y);
+  }
+
+  // `log(1 + x) / x` and `(e^x - 1) / x`, without cancellation near 0
+  static double log1p_ratio(double const x) {
+    if (std::abs(x) > 1e-8) {
+      return std::log1p(x) / x;
+    }
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - x * 0.25));
+  }
+
+  static double expm1_ratio(double const x) {
+    if (std::abs(x) > 1e-8) {
+      return std::expm1(x) / x;
+    }
+    return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + x * 0.25));
+  }
+};
+
+/*
+ * Bernoulli sampling by skips
+ * keeps each item of a stream with chance `p`. the gaps between kept items
+ * are geometric, so a gap is drawn at once instead of a coin per item:
+ * `O(p n)` draws for `n` items.
+ */
+class BernoulliSkip {
+  double p_;
+  // `log(1 - p)`
+  double log_q_;
+
+ public:
+  explicit BernoulliSkip(double const p) : p_{p}, log_q_{std::log1p(-p)} {
+    if (!(p >= 0 && p <= 1)) {
+      throw std::runtime_error("BernoulliSkip error: p out of [0, 1]");
+    }
+  }
+
+  // items to pass over before the next one kept
+  template <Rng64 G>
+  uint64_t operator()(G& g) const {
+    if (p_ == 1.0) {
+      return 0;
+    }
+    if (p_ == 0.0) {
+      return std::numeric_limits<uint64_t>::max();
+    }
+    double const gap = std::floor(std::log(1.0 - unit(g)) / log_q_);
+    return gap < 0x1.0p63 ? static_cast<uint64_t>(gap)
+                          : std::numeric_limits<uint64_t>::max();
+  }
+
+  // indices of the items kept among `n`, ascending
+  template <Rng64 G>
+  std::vector<size_t> indices(size_t const n, G& g) const {
+    std::vector<size_t> r;
+    uint64_t i = (*this)(g);
+    while (i < n) {
+      r.push_back(static_cast<size_t>(i));
+      uint64_t const gap = (*this)(g);
+      if (gap >= n - i - 1) {
+        break;
+      }
+      i += gap + 1;
+    }
+    return r;
+  }
+};
+
+/*
+ * fill `a` with `draw(g)` in parallel, e.g. `draw` a `Zipf` or an
+ * `AliasTable`. blocks of fixed length get a generator each, seeded in turn
+ * from `seed`, so the output depends on `seed` only, not on the threads.
+ */
+template <typename T, typename Draw>
+void parallel_generate(std::vector<T>& a,
+                       uint64_t const seed,
+                       Draw const& draw,
+                       Scheduler& sched = Scheduler::instance()) {
+  constexpr size_t BLOCK = 1 << 14;
+  size_t const n = a.size();
+  SplitMix64 sm(seed);
+  TaskGroup tg(sched);
+  for (size_t lo = 0; lo < n; lo += BLOCK) {
+    size_t const hi = std::min(lo + BLOCK, n);
+    tg.run([&a, &draw, lo, hi, s = sm()] {
+      Xoshiro256 g(s);
+      for (size_t i = lo; i < hi; i++) {
+        a[i] = static_cast<T>(draw(g));
+      }
+    });
+  }
+  tg.wait();
+}
+};  // namespace alg
+
+#endif  // !__ALG_RANDOM_SAMPLING_HPP__
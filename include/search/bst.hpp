@@ -14,8 +14,8 @@
 namespace alg {
 template<typename Key,
          typename Val,
-         int (*cmp)(Key const& t1, Key const& t2) =
-             Order<Key>::default_three_way_comparator>
+         auto cmp = Order<Key>::default_three_way_comparator>
+	requires ThreeWayComparator<decltype(cmp), Key>
 class BST {
 	struct Node;
 	using Node   = struct Node;
@@ -1,6 +1,7 @@
 #ifndef __ALG_SEARCH_COMMON_HPP__
 #define __ALG_SEARCH_COMMON_HPP__
 
+#include <concepts>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -52,6 +53,21 @@ struct Hash<std::string> {
   }
 };
 
+/*
+ * hash functions accepted by the hash tables: function pointers such as
+ * `Hash<T>::hash`, or function objects such as `Hasher<T>`, which are inlined
+ */
+template <typename H, typename T>
+concept KeyHasher = requires(H const& h, T const& t) {
+  { h(t) } -> std::convertible_to<int>;
+};
+
+// `Hash<T>::hash` as a function object
+template <typename T>
+struct Hasher {
+  int operator()(T const& t) const { return Hash<T>::hash(t); }
+};
+
 };  // namespace alg
 
 #endif  // !__ALG_SEARCH_COMMON_HPP__
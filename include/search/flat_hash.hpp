@@ -0,0 +1,309 @@
+#ifndef __ALG_SEARCH_FLAT_HASH_HPP__
+#define __ALG_SEARCH_FLAT_HASH_HPP__
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <search/common.hpp>
+#include <sort/common.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace alg {
+/*
+ * hash table with open addressing, probed a group of 16 slots at a time
+ * (SwissTable)
+ * next to the slots is one control byte per slot: negative for a free slot,
+ * empty or deleted, otherwise 7 bits of the hash of its key. a lookup loads
+ * the 16 control bytes of a group and compares them all with the 7 bits of
+ * the key at once (SSE2, or a plain loop without it), so only the slots
+ * whose bits match, almost never more than the right one, are compared by
+ * key. a group with an empty slot ends the probe, otherwise the next group
+ * is taken by triangular steps, which visit every group.
+ *
+ * key-value pairs lie side by side in a single array, and the table grows
+ * past a 7/8 load. a deleted slot turns back to empty when its group still
+ * has an empty one, as no probe then went on beyond the group; otherwise it
+ * stays a tombstone until the next resize.
+ *
+ * the same interface as `LinearProbing`. the hash of a key is mixed by a
+ * multiplication, so hashes as weak as the identity on ints are fine.
+ */
+template <typename Key,
+          typename Val,
+          typename KeyHash = int (*)(Key const&),
+          typename KeyEq = bool (*)(Key const& t1, Key const& t2)>
+  requires KeyHasher<KeyHash, Key> && Comparator<KeyEq, Key>
+class FlatHash {
+  using OptVal = std::optional<Val>;
+  using VecKey = std::vector<Key>;
+  using Pair = std::pair<Key, Val>;
+  // bit `i` for slot `i` of a group
+  using Mask = uint32_t;
+
+  // uninitialized unless the control byte is full
+  union Slot {
+    Slot() {}
+    ~Slot() {}
+    Pair kv;
+  };
+
+  static constexpr int8_t EMPTY = -128;
+  static constexpr int8_t DELETED = -2;
+  static constexpr int GROUP = 16;
+
+  // number of key-value pairs
+  int n_;
+  // number of full or deleted slots
+  int used_;
+  // hash table size, a power of 2 and a multiple of `GROUP`
+  int m_;
+  // control bytes
+  std::vector<int8_t> ctrl_;
+  // key-value pairs
+  std::unique_ptr<Slot[]> slots_;
+  // hash-code function of key
+  [[no_unique_address]] KeyHash kh_;
+  // key equality
+  [[no_unique_address]] KeyEq ke_;
+  // initial capacity
+  constexpr static int INIT_CAPACITY = GROUP;
+
+ public:
+  FlatHash(KeyHash kh,
+           int const m = INIT_CAPACITY,
+           KeyEq ke = default_of<KeyEq, Order<Key>::equal>())
+      : n_{0}, used_{0}, m_{0}, kh_{kh}, ke_{ke} {
+    if (m < 0) {
+      std::cerr << "Error initializing flat hash symbol table: invalid "
+                   "capacity which is negtive. init with default capacity\n";
+      init(INIT_CAPACITY);
+    } else {
+      init(std::max(GROUP, static_cast<int>(std::bit_ceil(unsigned(m)))));
+    }
+  }
+
+  // hash function object constructed by default
+  explicit FlatHash(int const m = INIT_CAPACITY)
+    requires(!std::is_pointer_v<KeyHash>)
+      : FlatHash(KeyHash{}, m) {}
+
+  FlatHash(FlatHash const& o) : FlatHash(o.kh_, o.m_, o.ke_) {
+    for (int i = 0; i < o.m_; i++) {
+      if (o.ctrl_[i] >= 0) {
+        insert(o.slots_[i].kv.first, o.slots_[i].kv.second, mix(o.key(i)));
+      }
+    }
+  }
+
+  FlatHash(FlatHash&& o) noexcept
+      : n_{o.n_},
+        used_{o.used_},
+        m_{o.m_},
+        ctrl_{std::move(o.ctrl_)},
+        slots_{std::move(o.slots_)},
+        kh_{o.kh_},
+        ke_{o.ke_} {
+    o.n_ = o.used_ = o.m_ = 0;
+    o.ctrl_.clear();
+  }
+
+  FlatHash& operator=(FlatHash o) noexcept {
+    swap(o);
+    return *this;
+  }
+
+  ~FlatHash() { destroy(); }
+
+  int size() const { return n_; }
+
+  bool contains(Key const& key) const { return find(key, mix(key)) >= 0; }
+
+  OptVal get(Key const& key) const {
+    int const i = find(key, mix(key));
+    if (i < 0) {
+      return std::nullopt;
+    }
+    return slots_[i].kv.second;
+  }
+
+  void put(Key const& key, Val const& val) {
+    uint64_t const h = mix(key);
+    int const i = find(key, h);
+    if (i >= 0) {
+      slots_[i].kv.second = val;
+      return;
+    }
+    if (used_ >= m_ / 8 * 7) {
+      // grow, or only clear the tombstones if they are the most of it
+      resize(std::max(INIT_CAPACITY, 2 * n_ >= m_ ? 2 * m_ : m_));
+    }
+    insert(key, val, h);
+  }
+
+  void del(Key const& key) {
+    int const i = find(key, mix(key));
+    if (i < 0) {
+      std::cout << "Cannot delete key-value pair: given key not exist\n";
+      return;
+    }
+    std::destroy_at(&slots_[i].kv);
+    n_--;
+    if (match(&ctrl_[i / GROUP * GROUP], EMPTY) != 0) {
+      ctrl_[i] = EMPTY;
+      used_--;
+    } else {
+      ctrl_[i] = DELETED;
+    }
+
+    if (n_ > 0 && n_ <= m_ / 8 && m_ > INIT_CAPACITY) {
+      resize(m_ / 2);
+    }
+  }
+
+  VecKey keys() const {
+    VecKey vk;
+    vk.reserve(n_);
+    for (int i = 0; i < m_; i++) {
+      if (ctrl_[i] >= 0) {
+        vk.push_back(key(i));
+      }
+    }
+    return vk;
+  }
+
+ private:
+  void init(int const m) {
+    m_ = m;
+    ctrl_.assign(m_, EMPTY);
+    slots_ = std::make_unique<Slot[]>(m_);
+  }
+
+  // move every pair into a table of `new_m` slots
+  void resize(int const new_m) {
+    FlatHash t(kh_, new_m, ke_);
+    for (int i = 0; i < m_; i++) {
+      if (ctrl_[i] >= 0) {
+        Pair& kv = slots_[i].kv;
+        uint64_t const h = mix(kv.first);
+        t.insert(std::move(kv.first), std::move(kv.second), h);
+      }
+    }
+    swap(t);
+  }
+
+  void destroy() {
+    for (int i = 0; i < m_; i++) {
+      if (ctrl_[i] >= 0) {
+        std::destroy_at(&slots_[i].kv);
+      }
+    }
+  }
+
+  void swap(FlatHash& o) noexcept {
+    std::swap(n_, o.n_);
+    std::swap(used_, o.used_);
+    std::swap(m_, o.m_);
+    ctrl_.swap(o.ctrl_);
+    slots_.swap(o.slots_);
+    std::swap(kh_, o.kh_);
+    std::swap(ke_, o.ke_);
+  }
+
+  Key const& key(int const i) const { return slots_[i].kv.first; }
+
+  // hash code of key times the 64-bit golden ratio: the high half picks the
+  // first group, bits 25 to 31 go to the control byte
+  uint64_t mix(Key const& key) const {
+    uint32_t const h = static_cast<uint32_t>(kh_(key));
+    return uint64_t(h) * 0x9e3779b97f4a7c15ull;
+  }
+
+  static int8_t tag(uint64_t const h) {
+    return static_cast<int8_t>((h >> 25) & 0x7f);
+  }
+
+  // slot of `key`, or -1
+  int find(Key const& key, uint64_t const h) const {
+    if (m_ == 0) {
+      return -1;
+    }
+    int const groups = m_ / GROUP;
+    int8_t const t = tag(h);
+    int g = static_cast<int>((h >> 32) & (groups - 1));
+    for (int step = 1;; step++) {
+      int8_t const* const c = &ctrl_[g * GROUP];
+      for (Mask m = match(c, t); m != 0; m &= m - 1) {
+        int const i = g * GROUP + std::countr_zero(m);
+        if (ke_(key, slots_[i].kv.first)) {
+          return i;
+        }
+      }
+      if (match(c, EMPTY) != 0) {
+        return -1;
+      }
+      g = (g + step) & (groups - 1);
+    }
+  }
+
+  // put a key not in the table into the first free slot of its probe
+  template <typename K, typename V>
+  void insert(K&& key, V&& val, uint64_t const h) {
+    int const groups = m_ / GROUP;
+    int g = static_cast<int>((h >> 32) & (groups - 1));
+    for (int step = 1;; step++) {
+      Mask const m = match_free(&ctrl_[g * GROUP]);
+      if (m != 0) {
+        int const i = g * GROUP + std::countr_zero(m);
+        used_ += ctrl_[i] == EMPTY;
+        ctrl_[i] = tag(h);
+        std::construct_at(&slots_[i].kv, std::forward<K>(key),
+                          std::forward<V>(val));
+        n_++;
+        return;
+      }
+      g = (g + step) & (groups - 1);
+    }
+  }
+
+  // slots of group `c` whose control byte is `b`
+  static Mask match(int8_t const* const c, int8_t const b) {
+#if defined(__SSE2__)
+    __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(c));
+    return static_cast<Mask>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(b))));
+#else
+    Mask m = 0;
+    for (int i = 0; i < GROUP; i++) {
+      m |= Mask(c[i] == b) << i;
+    }
+    return m;
+#endif
+  }
+
+  // empty or deleted slots of group `c`: the sign bits
+  static Mask match_free(int8_t const* const c) {
+#if defined(__SSE2__)
+    __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(c));
+    return static_cast<Mask>(_mm_movemask_epi8(x));
+#else
+    Mask m = 0;
+    for (int i = 0; i < GROUP; i++) {
+      m |= Mask(c[i] < 0) << i;
+    }
+    return m;
+#endif
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SEARCH_FLAT_HASH_HPP__
@@ -6,20 +6,30 @@
 #include <list>
 #include <optional>
 #include <queue>
+#include <search/common.hpp>
 #include <sort/common.hpp>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace alg {
-template <typename Key, typename Val>
+/*
+ * hash table with linear probing
+ * the hash function and key equality are function pointers by default, or
+ * any function objects given as `KeyHash` and `KeyEq` (e.g. `Hasher<Key>` and
+ * `std::equal_to<Key>`), whose calls are inlined
+ */
+template <typename Key,
+          typename Val,
+          typename KeyHash = int (*)(Key const&),
+          typename KeyEq = bool (*)(Key const& t1, Key const& t2)>
+  requires KeyHasher<KeyHash, Key> && Comparator<KeyEq, Key>
 class LinearProbing {
   using OptKey = std::optional<Key>;
   using OptVal = std::optional<Val>;
   using VecKey = std::vector<Key>;
   using VecOptKey = std::vector<OptKey>;
   using VecOptVal = std::vector<OptVal>;
-  using KeyHash = int (*)(Key const&);
-  using KeyEq = bool (*)(Key const& t1, Key const& t2);
 
   // number of key-value pairs
   int n_;
@@ -30,16 +40,16 @@ class LinearProbing {
   // vals (possibly null)
   VecOptVal vals_;
   // hash-code function of key
-  KeyHash kh_;
+  [[no_unique_address]] KeyHash kh_;
   // key equality
-  KeyEq ke_;
+  [[no_unique_address]] KeyEq ke_;
   // initial capacity
   constexpr static int INIT_CAPACITY = 4;
 
  public:
   LinearProbing(KeyHash kh,
                 int const m = INIT_CAPACITY,
-                KeyEq ke = Order<Key>::equal)
+                KeyEq ke = default_of<KeyEq, Order<Key>::equal>())
       : n_{0}, kh_{kh}, ke_{ke} {
     if (m < 0) {
       std::cerr << "Error initializing linear-probing symbol table: invalid "
@@ -53,6 +63,11 @@ class LinearProbing {
     }
   }
 
+  // hash function object constructed by default
+  explicit LinearProbing(int const m = INIT_CAPACITY)
+    requires(!std::is_pointer_v<KeyHash>)
+      : LinearProbing(KeyHash{}, m) {}
+
   int size() { return n_; }
 
   bool contains(Key const& key) { return get(key).has_value(); }
@@ -133,7 +148,7 @@ class LinearProbing {
     vals_ = std::move(new_linear_probing.vals_);
   }
 
-  int hash(Key const key) const {
+  int hash(Key const& key) const {
     int h = kh_(key);
     h ^= (h >> 20) ^ (h >> 12) ^ (h >> 7) ^ (h >> 4);
     return h & (m_ - 1);
@@ -23,11 +23,13 @@
 #include <vector>
 
 namespace alg {
-template <typename Key, typename Val>
+template <typename Key,
+          typename Val,
+          typename Cmp = int (*)(Key const& t1, Key const& t2)>
+  requires ThreeWayComparator<Cmp, Key>
 class LLRB {
   struct Node;
   using Node = struct Node;
-  using Cmp = int (*)(Key const& t1, Key const& t2);
   using OptVal = std::optional<Val>;
   using OptKey = std::optional<Key>;
   using UniPtr = std::unique_ptr<Node>;
@@ -51,10 +53,12 @@ class LLRB {
   };
 
   UniPtr root_;
-  Cmp cmp_;
+  [[no_unique_address]] Cmp cmp_;
 
  public:
-  LLRB(Cmp cmp = Order<Key>::default_three_way_comparator)
+  // `Cmp` is a three-way comparator, a function pointer by default, or any
+  // function object whose calls are inlined
+  LLRB(Cmp cmp = default_of<Cmp, Order<Key>::default_three_way_comparator>())
       : root_{nullptr}, cmp_{cmp} {}
 
   // return the size of the tree
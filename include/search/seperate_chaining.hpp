@@ -6,12 +6,23 @@
 #include <list>
 #include <optional>
 #include <queue>
+#include <search/common.hpp>
 #include <sort/common.hpp>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace alg {
-template <typename Key, typename Val>
+/*
+ * hash table with separate chaining
+ * the hash function and key equality are function pointers by default, or
+ * any function objects given as `KeyHash` and `KeyEq`, whose calls are inlined
+ */
+template <typename Key,
+          typename Val,
+          typename KeyHash = int (*)(Key const&),
+          typename KeyEq = bool (*)(Key const& t1, Key const& t2)>
+  requires KeyHasher<KeyHash, Key> && Comparator<KeyEq, Key>
 class SeperateChaining {
   struct Pair;
   struct List;
@@ -19,8 +30,6 @@ class SeperateChaining {
   using OptPair = std::optional<Pair>;
   using OptVal = std::optional<Val>;
   using ST = std::vector<List>;
-  using KeyHash = int (*)(Key const&);
-  using KeyEq = bool (*)(Key const& t1, Key const& t2);
   using VecKey = std::vector<Key>;
   using VecPair = std::vector<Pair>;
 
@@ -33,7 +42,7 @@ class SeperateChaining {
 
   struct List {
     std::list<Pair> l_;
-    KeyEq ke_;
+    [[no_unique_address]] KeyEq ke_;
 
     List(KeyEq ke) : ke_{ke} {}
 
@@ -95,16 +104,16 @@ class SeperateChaining {
   // array of linked-list symbol tables
   ST st_;
   // hash-code function of key
-  KeyHash kh_;
+  [[no_unique_address]] KeyHash kh_;
   // key equality
-  KeyEq ke_;
+  [[no_unique_address]] KeyEq ke_;
   // initial capacity
   static constexpr int INIT_CAPACITY = 4;
 
  public:
   SeperateChaining(KeyHash kh,
                    int const m = INIT_CAPACITY,
-                   KeyEq ke = Order<Key>::equal)
+                   KeyEq ke = default_of<KeyEq, Order<Key>::equal>())
       : n_{0}, kh_{kh}, ke_{ke} {
     if (m < 0) {
       std::cerr << "Error initializing seperate-chaining symbol table: invalid "
@@ -117,6 +126,11 @@ class SeperateChaining {
     }
   }
 
+  // hash function object constructed by default
+  explicit SeperateChaining(int const m = INIT_CAPACITY)
+    requires(!std::is_pointer_v<KeyHash>)
+      : SeperateChaining(KeyHash{}, m) {}
+
   int size() { return n_; }
 
   bool contains(Key const& key) { return get(key).has_value(); }
@@ -166,7 +180,7 @@ class SeperateChaining {
     st_ = std::move(new_seperate_chaining.st_);
   }
 
-  int hash(Key const key) const {
+  int hash(Key const& key) const {
     int h = kh_(key);
     h ^= (h >> 20) ^ (h >> 12) ^ (h >> 7) ^ (h >> 4);
     return h & (m_ - 1);
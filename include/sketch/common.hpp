@@ -0,0 +1,72 @@
+#ifndef __ALG_SKETCH_COMMON_HPP__
+#define __ALG_SKETCH_COMMON_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alg {
+/*
+ * flat byte buffers for the serialized form of sketches. values are copied
+ * as laid out in memory, so a buffer is read back on machines of the same
+ * byte order and type sizes, e.g. shards of one cluster.
+ */
+class ByteWriter {
+  std::vector<uint8_t> bytes_;
+
+ public:
+  template <typename U>
+    requires std::is_trivially_copyable_v<U>
+  void put(U const& x) {
+    put(&x, 1);
+  }
+
+  template <typename U>
+    requires std::is_trivially_copyable_v<U>
+  void put(U const* p, size_t const n) {
+    size_t const at = bytes_.size();
+    bytes_.resize(at + n * sizeof(U));
+    if (n > 0) {
+      std::memcpy(bytes_.data() + at, p, n * sizeof(U));
+    }
+  }
+
+  std::vector<uint8_t> take() { return std::move(bytes_); }
+};
+
+class ByteReader {
+  std::vector<uint8_t> const& bytes_;
+  size_t pos_ = 0;
+
+ public:
+  explicit ByteReader(std::vector<uint8_t> const& bytes) : bytes_{bytes} {}
+
+  template <typename U>
+    requires std::is_trivially_copyable_v<U>
+  U get() {
+    U x;
+    get(&x, 1);
+    return x;
+  }
+
+  template <typename U>
+    requires std::is_trivially_copyable_v<U>
+  void get(U* p, size_t const n) {
+    if (n > (bytes_.size() - pos_) / sizeof(U)) {
+      throw std::runtime_error("ByteReader error: truncated input");
+    }
+    if (n > 0) {
+      std::memcpy(p, bytes_.data() + pos_, n * sizeof(U));
+    }
+    pos_ += n * sizeof(U);
+  }
+
+  bool done() const { return pos_ == bytes_.size(); }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SKETCH_COMMON_HPP__
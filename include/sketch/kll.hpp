@@ -0,0 +1,290 @@
+#ifndef __ALG_SKETCH_KLL_HPP__
+#define __ALG_SKETCH_KLL_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <random/prng.hpp>
+#include <sketch/common.hpp>
+#include <sort/common.hpp>
+
+namespace alg {
+/*
+ * KLL quantile sketch (Karnin, Lang and Liberty)
+ * a stack of compactors: level `h` holds items standing for `2^h` inputs
+ * each. a full level is sorted, and every other item, from a random first
+ * one, moves up a level while the rest is dropped; the total weight stays
+ * exactly the number of items added. capacities shrink by `2 / 3` per level
+ * down from `k` at the top, so the sketch holds `O(k)` items whatever the
+ * length of the stream.
+ *
+ * the rank of any item is estimated within `O(n / k)`: for `k = 200`, about
+ * 1.7% of `n` with 99% probability. quantiles are items of the stream, and
+ * `min` and `max` are exact.
+ *
+ * two sketches of the same `k` merge into one of their union, as accurate
+ * as a single sketch of it, so shards or threads each sketch their part.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class KLL {
+  using Vector = std::vector<T>;
+
+  static constexpr uint32_t TAG = 0x4b4c4c31;  // "KLL1"
+  static constexpr size_t MIN_CAPACITY = 8;
+
+  size_t k_;
+  // `levels_[h]`: the compactor of weight `2^h`
+  std::vector<Vector> levels_;
+  uint64_t n_ = 0;
+  // items held, and held at most before a compaction
+  size_t size_ = 0;
+  size_t max_size_ = 0;
+  T min_{}, max_{};
+  Xoshiro256 rng_;
+
+ public:
+  explicit KLL(size_t const k = 200) : KLL(k, thread_rng()()) {}
+
+  KLL(size_t const k, uint64_t const seed) : k_{k}, rng_(seed) {
+    if (k < 2) {
+      throw std::runtime_error("KLL error: k must be at least 2");
+    }
+    grow();
+  }
+
+  size_t k() const { return k_; }
+
+  // items added, merged ones included
+  uint64_t count() const { return n_; }
+
+  bool empty() const { return n_ == 0; }
+
+  // items held by the sketch
+  size_t size() const { return size_; }
+
+  T const& min() const {
+    check();
+    return min_;
+  }
+
+  T const& max() const {
+    check();
+    return max_;
+  }
+
+  void add(T const& x) {
+    if (n_ == 0 || cmp(x, min_)) {
+      min_ = x;
+    }
+    if (n_ == 0 || cmp(max_, x)) {
+      max_ = x;
+    }
+    n_++;
+    levels_[0].push_back(x);
+    if (++size_ >= max_size_) {
+      compress();
+    }
+  }
+
+  void merge(KLL const& other) {
+    if (other.k_ != k_) {
+      throw std::runtime_error("KLL error: merging sketches of distinct k");
+    }
+    if (other.n_ == 0) {
+      return;
+    }
+    if (&other == this) {
+      KLL const copy = other;
+      merge(copy);
+      return;
+    }
+    if (n_ == 0 || cmp(other.min_, min_)) {
+      min_ = other.min_;
+    }
+    if (n_ == 0 || cmp(max_, other.max_)) {
+      max_ = other.max_;
+    }
+    n_ += other.n_;
+    while (levels_.size() < other.levels_.size()) {
+      grow();
+    }
+    for (size_t h = 0; h < other.levels_.size(); h++) {
+      levels_[h].insert(levels_[h].end(), other.levels_[h].begin(),
+                        other.levels_[h].end());
+      size_ += other.levels_[h].size();
+    }
+    while (size_ >= max_size_) {
+      compress();
+    }
+  }
+
+  // estimated number of items added less than `x`
+  uint64_t rank(T const& x) const {
+    uint64_t r = 0;
+    for (size_t h = 0; h < levels_.size(); h++) {
+      for (T const& y : levels_[h]) {
+        if (cmp(y, x)) {
+          r += uint64_t(1) << h;
+        }
+      }
+    }
+    return r;
+  }
+
+  // item of rank about `q * count()`, `q` in `[0, 1]`
+  T quantile(double const q) const { return quantiles({q})[0]; }
+
+  // many quantiles at the cost of one
+  Vector quantiles(std::vector<double> const& qs) const {
+    check();
+    std::vector<std::pair<T, uint64_t>> items;
+    items.reserve(size_);
+    for (size_t h = 0; h < levels_.size(); h++) {
+      for (T const& y : levels_[h]) {
+        items.emplace_back(y, uint64_t(1) << h);
+      }
+    }
+    std::sort(items.begin(), items.end(), [](auto const& a, auto const& b) {
+      return cmp(a.first, b.first);
+    });
+    Vector r;
+    r.reserve(qs.size());
+    for (double const q : qs) {
+      if (!(q >= 0 && q <= 1)) {
+        throw std::runtime_error("KLL error: quantile out of [0, 1]");
+      }
+      if (q == 0) {
+        r.push_back(min_);
+        continue;
+      }
+      if (q == 1) {
+        r.push_back(max_);
+        continue;
+      }
+      // first item whose cumulative weight passes `q * n`
+      double const target = q * static_cast<double>(n_);
+      uint64_t sum = 0;
+      size_t i = 0;
+      while (i + 1 < items.size() &&
+             static_cast<double>(sum + items[i].second) <= target) {
+        sum += items[i++].second;
+      }
+      r.push_back(items[i].first);
+    }
+    return r;
+  }
+
+  std::vector<uint8_t> serialize() const
+    requires std::is_trivially_copyable_v<T>
+  {
+    ByteWriter w;
+    w.put(TAG);
+    w.put(uint64_t(k_));
+    w.put(n_);
+    w.put(min_);
+    w.put(max_);
+    w.put(uint64_t(levels_.size()));
+    for (Vector const& level : levels_) {
+      w.put(uint64_t(level.size()));
+      w.put(level.data(), level.size());
+    }
+    return w.take();
+  }
+
+  static KLL deserialize(std::vector<uint8_t> const& bytes)
+    requires std::is_trivially_copyable_v<T>
+  {
+    ByteReader r(bytes);
+    if (r.get<uint32_t>() != TAG) {
+      throw std::runtime_error("KLL error: not a serialized KLL sketch");
+    }
+    KLL s(static_cast<size_t>(r.get<uint64_t>()));
+    s.n_ = r.get<uint64_t>();
+    s.min_ = r.get<T>();
+    s.max_ = r.get<T>();
+    uint64_t const height = r.get<uint64_t>();
+    if (height == 0 || height > 64) {
+      throw std::runtime_error("KLL error: corrupt serialized sketch");
+    }
+    while (s.levels_.size() < height) {
+      s.grow();
+    }
+    uint64_t weight = 0;
+    for (size_t h = 0; h < height; h++) {
+      uint64_t const m = r.get<uint64_t>();
+      if (m > bytes.size()) {
+        throw std::runtime_error("KLL error: corrupt serialized sketch");
+      }
+      s.levels_[h].resize(m);
+      r.get(s.levels_[h].data(), m);
+      s.size_ += m;
+      weight += m << h;
+    }
+    if (!r.done() || weight != s.n_) {
+      throw std::runtime_error("KLL error: corrupt serialized sketch");
+    }
+    return s;
+  }
+
+ private:
+  void check() const {
+    if (n_ == 0) {
+      throw std::runtime_error("KLL error: sketch is empty");
+    }
+  }
+
+  // capacity of level `h`, `k * (2 / 3)^depth` below the top
+  size_t capacity(size_t const h) const {
+    size_t const depth = levels_.size() - 1 - h;
+    size_t const c =
+        static_cast<size_t>(std::ceil(k_ * std::pow(2.0 / 3.0, depth)));
+    return std::max(c, MIN_CAPACITY);
+  }
+
+  void grow() {
+    levels_.emplace_back();
+    max_size_ = 0;
+    for (size_t h = 0; h < levels_.size(); h++) {
+      max_size_ += capacity(h);
+    }
+  }
+
+  // compact the lowest full level
+  void compress() {
+    for (size_t h = 0; h < levels_.size(); h++) {
+      if (levels_[h].size() < capacity(h)) {
+        continue;
+      }
+      if (h + 1 == levels_.size()) {
+        grow();
+      }
+      Vector& level = levels_[h];
+      Vector& up = levels_[h + 1];
+      std::sort(level.begin(), level.end(),
+                [](T const& a, T const& b) { return cmp(a, b); });
+      // an odd item out stays at this level
+      size_t const m = level.size() & ~size_t(1);
+      for (size_t i = rng_() & 1; i < m; i += 2) {
+        up.push_back(std::move(level[i]));
+      }
+      size_ -= m / 2;
+      if (m < level.size()) {
+        level[0] = std::move(level[m]);
+        level.resize(1);
+      } else {
+        level.clear();
+      }
+      return;
+    }
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SKETCH_KLL_HPP__
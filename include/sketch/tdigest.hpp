@@ -0,0 +1,303 @@
+#ifndef __ALG_SKETCH_TDIGEST_HPP__
+#define __ALG_SKETCH_TDIGEST_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include <sketch/common.hpp>
+
+namespace alg {
+/*
+ * t-digest (Dunning), the merging variant
+ * the distribution as a sorted list of centroids, a mean and a weight each.
+ * added values gather in a buffer; a full buffer is sorted together with the
+ * centroids, and neighbours are merged in one pass while the scale function
+ * `k(q) = d / (2 pi) asin(2q - 1)` grows by at most 1 over a centroid. `k` is
+ * steep near `q = 0` and `q = 1`, so centroids there stay small, down to
+ * single values: at most about `d` centroids, and errors relative to
+ * `q (1 - q)` rather than to `n`.
+ *
+ * quantiles interpolate linearly between the centers of centroids, and
+ * `min` and `max` are exact. there is no worst-case bound; for the default
+ * `d = 100`, the rank of a quantile is typically within 0.5% around the
+ * median and within 0.05% at the 0.1% and 99.9% tails.
+ *
+ * digests merge whatever their compressions, by adding the centroids of one
+ * as weighted values to the other.
+ *
+ * queries merge the buffer first: even `const` calls on one digest must not
+ * run concurrently.
+ */
+class TDigest {
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  static constexpr uint32_t TAG = 0x54444731;  // "TDG1"
+  // the buffer holds `5 d` values
+  static constexpr double MAX_COMPRESSION = 1e5;
+
+  double d_;
+  // centroids sorted by mean, and values not merged into them yet
+  mutable std::vector<Centroid> centroids_;
+  mutable std::vector<Centroid> buffer_;
+  size_t buffer_capacity_;
+  double n_ = 0;
+  double min_ = std::numeric_limits<double>::infinity();
+  double max_ = -std::numeric_limits<double>::infinity();
+
+ public:
+  explicit TDigest(double const compression = 100)
+      : d_{compression}, buffer_capacity_{buffer_capacity(compression)} {
+    buffer_.reserve(buffer_capacity_);
+  }
+
+  double compression() const { return d_; }
+
+  // total weight added, merged digests included
+  double count() const { return n_; }
+
+  bool empty() const { return n_ == 0; }
+
+  // centroids held, after merging the buffer
+  size_t size() const {
+    flush();
+    return centroids_.size();
+  }
+
+  double min() const {
+    check();
+    return min_;
+  }
+
+  double max() const {
+    check();
+    return max_;
+  }
+
+  void add(double const x, double const w = 1) {
+    if (std::isnan(x) || !(w > 0) || !std::isfinite(w)) {
+      throw std::runtime_error("TDigest error: invalid value or weight");
+    }
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+    n_ += w;
+    buffer_.push_back({x, w});
+    if (buffer_.size() >= buffer_capacity_) {
+      flush();
+    }
+  }
+
+  void merge(TDigest const& other) {
+    if (other.n_ == 0) {
+      return;
+    }
+    if (&other == this) {
+      TDigest const copy = other;
+      merge(copy);
+      return;
+    }
+    other.flush();
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    n_ += other.n_;
+    for (Centroid const& c : other.centroids_) {
+      buffer_.push_back(c);
+      if (buffer_.size() >= buffer_capacity_) {
+        flush();
+      }
+    }
+  }
+
+  // estimated fraction of the weight below `x`, half of the weight at `x`
+  double cdf(double const x) const {
+    check();
+    if (x < min_) {
+      return 0;
+    }
+    if (x >= max_) {
+      return 1;
+    }
+    flush();
+    // the same broken line as `quantile`, read the other way
+    double left_x = min_, left_w = 0;
+    double before = 0;
+    for (Centroid const& c : centroids_) {
+      double const center = before + c.weight / 2;
+      if (x < c.mean) {
+        return interpolate(x, left_x, c.mean, left_w, center) / n_;
+      }
+      left_x = c.mean;
+      left_w = center;
+      before += c.weight;
+    }
+    return interpolate(x, left_x, max_, left_w, n_) / n_;
+  }
+
+  // value of rank about `q * count()`, `q` in `[0, 1]`
+  double quantile(double const q) const {
+    check();
+    if (!(q >= 0 && q <= 1)) {
+      throw std::runtime_error("TDigest error: quantile out of [0, 1]");
+    }
+    flush();
+    // a broken line through `(0, min)`, the centers of the centroids by
+    // cumulative weight, and `(n, max)`
+    double const target = q * n_;
+    double left_x = min_, left_w = 0;
+    double before = 0;
+    for (Centroid const& c : centroids_) {
+      double const center = before + c.weight / 2;
+      if (target < center) {
+        return interpolate(target, left_w, center, left_x, c.mean);
+      }
+      left_x = c.mean;
+      left_w = center;
+      before += c.weight;
+    }
+    return interpolate(target, left_w, n_, left_x, max_);
+  }
+
+  std::vector<uint8_t> serialize() const {
+    flush();
+    ByteWriter w;
+    w.put(TAG);
+    w.put(d_);
+    w.put(n_);
+    w.put(min_);
+    w.put(max_);
+    w.put(uint64_t(centroids_.size()));
+    w.put(centroids_.data(), centroids_.size());
+    return w.take();
+  }
+
+  static TDigest deserialize(std::vector<uint8_t> const& bytes) {
+    ByteReader r(bytes);
+    if (r.get<uint32_t>() != TAG) {
+      throw std::runtime_error("TDigest error: not a serialized t-digest");
+    }
+    TDigest t(r.get<double>());
+    t.n_ = r.get<double>();
+    t.min_ = r.get<double>();
+    t.max_ = r.get<double>();
+    uint64_t const m = r.get<uint64_t>();
+    if (m > bytes.size()) {
+      throw std::runtime_error("TDigest error: corrupt serialized digest");
+    }
+    t.centroids_.resize(m);
+    r.get(t.centroids_.data(), m);
+    if (!r.done() || !t.consistent()) {
+      throw std::runtime_error("TDigest error: corrupt serialized digest");
+    }
+    return t;
+  }
+
+ private:
+  // checked before anything is sized by `compression`
+  static size_t buffer_capacity(double const compression) {
+    if (!(compression >= 10 && compression <= MAX_COMPRESSION)) {
+      throw std::runtime_error(
+          "TDigest error: compression out of [10, 100000]");
+    }
+    return static_cast<size_t>(compression) * 5;
+  }
+
+  void check() const {
+    if (n_ == 0) {
+      throw std::runtime_error("TDigest error: digest is empty");
+    }
+  }
+
+  // centroids of positive weights summing to `n_`, sorted by mean within
+  // `[min_, max_]`, as `quantile` and `cdf` take them to be
+  bool consistent() const {
+    if (centroids_.empty()) {
+      return n_ == 0;
+    }
+    if (!(std::isfinite(n_) && n_ > 0 && min_ <= max_ &&
+          std::isfinite(min_) && std::isfinite(max_))) {
+      return false;
+    }
+    double total = 0;
+    double prev = min_;
+    for (Centroid const& c : centroids_) {
+      if (!(c.weight > 0 && std::isfinite(c.weight) && c.mean >= prev &&
+            c.mean <= max_)) {
+        return false;
+      }
+      total += c.weight;
+      prev = c.mean;
+    }
+    // the weights are summed in another order than `n_` was
+    return std::abs(total - n_) <= 1e-9 * n_;
+  }
+
+  // `y` at `x` on the line through `(x0, y0)` and `(x1, y1)`
+  static double interpolate(double const x,
+                            double const x0,
+                            double const x1,
+                            double const y0,
+                            double const y1) {
+    if (x1 <= x0) {
+      return y1;
+    }
+    return y0 + (x - x0) / (x1 - x0) * (y1 - y0);
+  }
+
+  double k(double const q) const {
+    return d_ / (2 * std::numbers::pi) * std::asin(2 * q - 1);
+  }
+
+  double k_inverse(double const k) const {
+    double const x = std::min(k * 2 * std::numbers::pi / d_,
+                              std::numbers::pi / 2);
+    return (std::sin(x) + 1) / 2;
+  }
+
+  // merge the buffer into the centroids
+  void flush() const {
+    if (buffer_.empty()) {
+      return;
+    }
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    std::sort(buffer_.begin(), buffer_.end(),
+              [](Centroid const& a, Centroid const& b) {
+                return a.mean < b.mean;
+              });
+    double total = 0;
+    for (Centroid const& c : buffer_) {
+      total += c.weight;
+    }
+    centroids_.clear();
+    Centroid cur = buffer_[0];
+    // weight up to the end of `cur`, and the most it may reach
+    double so_far = cur.weight;
+    double limit = total * k_inverse(k(0) + 1);
+    for (size_t i = 1; i < buffer_.size(); i++) {
+      Centroid const& c = buffer_[i];
+      if (so_far + c.weight <= limit) {
+        cur.weight += c.weight;
+        // never past `c` by rounding, so the centroids stay sorted
+        cur.mean = std::min(
+            c.mean, cur.mean + (c.mean - cur.mean) * c.weight / cur.weight);
+      } else {
+        centroids_.push_back(cur);
+        limit = total * k_inverse(k(so_far / total) + 1);
+        cur = c;
+      }
+      so_far += c.weight;
+    }
+    centroids_.push_back(cur);
+    buffer_.clear();
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SKETCH_TDIGEST_HPP__
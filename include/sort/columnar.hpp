@@ -0,0 +1,156 @@
+#ifndef __ALG_SORT_COLUMNAR_HPP__
+#define __ALG_SORT_COLUMNAR_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <sort/radix.hpp>
+
+namespace alg {
+enum class SortDirection { Ascending, Descending };
+
+// one key column of a `Columnar` sort and its direction
+template <RadixKey T>
+struct SortKey {
+  std::span<T const> column;
+  SortDirection direction = SortDirection::Ascending;
+};
+
+template <typename T>
+SortKey(std::vector<T> const&) -> SortKey<T>;
+
+template <typename T>
+SortKey(std::vector<T> const&, SortDirection) -> SortKey<T>;
+
+/*
+ * multi-column sort of a struct-of-arrays table
+ * sorts the row indices by several key columns, the first one the most
+ * significant, without ever building the rows: the result is a permutation
+ * `p`, and each column, keys or payload, is then gathered once in the order
+ * of `p`.
+ *
+ * the permutation is sorted by stable LSD passes, from the last key column
+ * to the first one. before the passes of a column, its keys are gathered in
+ * the current order of `p` and turned into `RadixBits`, complemented for a
+ * descending column, so the passes themselves only stream through the key
+ * bits and the indices side by side. as in `LSD`, the counts of all bytes of
+ * a column are taken in one sweep, and the bytes that are the same in every
+ * row are skipped.
+ *
+ * stable: rows with equal keys keep their order. -0.0 and +0.0 are equal
+ * keys, as for `<`.
+ */
+class Columnar {
+  static constexpr size_t R = 256;
+
+ public:
+  using Permutation = std::vector<size_t>;
+
+  // `p` such that the rows `p[0], p[1], ..` are sorted by `keys`
+  template <RadixKey... T>
+    requires(sizeof...(T) > 0)
+  static Permutation argsort(SortKey<T> const&... keys) {
+    std::array<size_t, sizeof...(T)> const sizes{keys.column.size()...};
+    size_t const n = sizes[0];
+    for (size_t const s : sizes) {
+      if (s != n) {
+        throw std::runtime_error("key columns of different sizes");
+      }
+    }
+    Permutation p(n);
+    std::iota(p.begin(), p.end(), size_t(0));
+    if (n < 2) {
+      return p;
+    }
+    Permutation aux(n);
+    sort_by(p, aux, keys...);
+    return p;
+  }
+
+  // `column[p[0]], column[p[1]], ..`
+  template <typename T>
+  static std::vector<T> gather(std::vector<T> const& column,
+                               Permutation const& p) {
+    if (column.size() != p.size()) {
+      throw std::runtime_error("column and permutation of different sizes");
+    }
+    std::vector<T> r;
+    r.reserve(p.size());
+    for (size_t const i : p) {
+      r.push_back(column[i]);
+    }
+    return r;
+  }
+
+  // reorder every column of a table by `p`
+  template <typename... T>
+  static void apply(Permutation const& p, std::vector<T>&... columns) {
+    ((columns = gather(columns, p)), ...);
+  }
+
+ private:
+  template <RadixKey T, RadixKey... U>
+  static void sort_by(Permutation& p,
+                      Permutation& aux,
+                      SortKey<T> const& key,
+                      SortKey<U> const&... rest) {
+    // the less significant columns first
+    if constexpr (sizeof...(U) > 0) {
+      sort_by(p, aux, rest...);
+    }
+    pass(key, p, aux);
+  }
+
+  // stable sort of `p` by one key column, byte by byte
+  template <RadixKey T>
+  static void pass(SortKey<T> const& key, Permutation& p, Permutation& aux) {
+    using Bits = typename RadixBits<T>::Bits;
+    constexpr size_t W = sizeof(T);
+
+    size_t const n = p.size();
+    Bits const flip =
+        key.direction == SortDirection::Descending ? Bits(~Bits(0)) : Bits(0);
+    std::vector<Bits> bits(n);
+    std::vector<std::array<size_t, R>> count(W);
+    for (auto& c : count) {
+      c.fill(0);
+    }
+    for (size_t i = 0; i < n; i++) {
+      Bits const b = RadixBits<T>::encode_value(key.column[p[i]]) ^ flip;
+      bits[i] = b;
+      for (size_t d = 0; d < W; d++) {
+        count[d][static_cast<uint8_t>(b >> (8 * d))]++;
+      }
+    }
+
+    std::vector<Bits> bits_aux(n);
+    for (size_t d = 0; d < W; d++) {
+      auto& c = count[d];
+      // constant byte, nothing would move
+      if (c[static_cast<uint8_t>(bits[0] >> (8 * d))] == n) {
+        continue;
+      }
+      size_t start = 0;
+      for (size_t r = 0; r < R; r++) {
+        size_t const cnt = c[r];
+        c[r] = start;
+        start += cnt;
+      }
+      for (size_t i = 0; i < n; i++) {
+        size_t const to = c[static_cast<uint8_t>(bits[i] >> (8 * d))]++;
+        bits_aux[to] = bits[i];
+        aux[to] = p[i];
+      }
+      bits.swap(bits_aux);
+      p.swap(aux);
+    }
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_COLUMNAR_HPP__
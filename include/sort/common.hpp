@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <type_traits>
 #include <vector>
 
 namespace alg {
@@ -42,6 +43,49 @@ class Order {
       [](T const& t1, T const& t2) { return t1 < t2 ? -1 : (t1 > t2 ? 1 : 0); };
 };
 
+/*
+ * comparators accepted as template arguments: the function pointers of
+ * `Order<T>`, stateless lambdas and function objects such as `std::less<T>`.
+ * a function object is known by its type, so every call is inlined into the
+ * inner loops instead of going through a pointer.
+ */
+template <typename C, typename T>
+concept Comparator = std::predicate<C const&, T const&, T const&>;
+
+// comparators returning < 0, 0 or > 0, like `default_three_way_comparator`
+template <typename C, typename T>
+concept ThreeWayComparator = requires(C const& c, T const& t) {
+  { c(t, t) } -> std::convertible_to<int>;
+};
+
+// `cmp` is the ascending order given by `<` of `T`
+template <typename T, auto cmp>
+constexpr bool is_less_order() {
+  using C = decltype(cmp);
+  if constexpr (std::is_same_v<C, bool (*)(T const&, T const&)>) {
+    // `Order<T>::less` does not even compile for `T` without `<`
+    if constexpr (requires(T const& t) { t < t; }) {
+      return cmp == Order<T>::less;
+    } else {
+      return false;
+    }
+  } else {
+    return std::is_same_v<C, std::less<T>> || std::is_same_v<C, std::less<>>;
+  }
+}
+
+// the default instance of a comparator type: `fallback` for function
+// pointers, which have no meaningful default, a value-initialized object
+// otherwise
+template <typename C, auto fallback>
+constexpr C default_of() {
+  if constexpr (std::is_pointer_v<C>) {
+    return fallback;
+  } else {
+    return C{};
+  }
+}
+
 };  // namespace alg
 
 #endif  // !__ALG_SORT_COMMON_HPP__
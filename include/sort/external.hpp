@@ -0,0 +1,258 @@
+#ifndef __ALG_SORT_EXTERNAL_HPP__
+#define __ALG_SORT_EXTERNAL_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <sort/common.hpp>
+#include <sort/loser_tree.hpp>
+#include <sort/quick.hpp>
+
+namespace alg {
+struct ExternalOptions {
+  // bytes of records held in memory at once, run buffer or merge buffers
+  size_t memory = size_t(1) << 28;
+  // number of runs merged at once, more runs take extra merge passes
+  size_t fan_in = 64;
+  // directory of the temporary run files
+  std::string temp_dir = "/tmp";
+};
+
+/*
+ * external merge sort of a binary file of fixed-width records
+ *
+ * 1. run generation: the input is read in chunks of `memory` bytes, each
+ *    sorted in memory by `IntroQuickX` and spilled to a temporary file
+ * 2. merge: up to `fan_in` runs are merged at once through a `LoserTree`,
+ *    every run and the output getting an equal share of `memory` as buffer,
+ *    until a single pass writes the output
+ *
+ * all file I/O goes through large sequential `fread` / `fwrite` calls on
+ * unbuffered streams. temporary files are unlinked as soon as they are
+ * created, so nothing is left behind even if the sort throws. the output is
+ * only opened once the input is fully read, so it may be the input itself.
+ *
+ * records are `T` as laid out in memory, so `T` must be trivially copyable.
+ * not stable, as `IntroQuickX` is not.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T> && std::is_trivially_copyable_v<T>
+class External {
+  using Vector = std::vector<T>;
+
+  struct Closer {
+    void operator()(FILE* f) const { std::fclose(f); }
+  };
+  using File = std::unique_ptr<FILE, Closer>;
+
+ public:
+  static void sort(std::string const& input, std::string const& output) {
+    sort(input, output, ExternalOptions{});
+  }
+
+  static void sort(std::string const& input,
+                   std::string const& output,
+                   ExternalOptions const& opt) {
+    size_t const capacity = opt.memory / sizeof(T);
+    if (opt.fan_in < 2) {
+      throw std::runtime_error("External sort: fan-in must be at least 2");
+    }
+    if (capacity < opt.fan_in + 1) {
+      throw std::runtime_error(
+          "External sort: memory budget below one record per merged run");
+    }
+
+    File in = open(input, "rb");
+    std::vector<File> runs;
+    {
+      Vector buf(capacity);
+      while (true) {
+        size_t const n = read(in.get(), buf.data(), capacity);
+        if (n == 0 && !runs.empty()) {
+          break;
+        }
+        buf.resize(n);
+        IntroQuickX<T, cmp>::sort(buf);
+        if (runs.empty() && n < capacity) {
+          // the whole input fits in memory
+          in.reset();
+          File out = open(output, "wb");
+          write(out.get(), buf.data(), n);
+          close(std::move(out), output);
+          return;
+        }
+        File run = temp_file(opt.temp_dir);
+        write(run.get(), buf.data(), n);
+        runs.push_back(std::move(run));
+        buf.resize(capacity);
+      }
+    }
+    in.reset();
+
+    // intermediate passes, each run of the next pass merged from `fan_in`
+    while (runs.size() > opt.fan_in) {
+      std::vector<File> next;
+      for (size_t b = 0; b < runs.size(); b += opt.fan_in) {
+        size_t const e = std::min(b + opt.fan_in, runs.size());
+        File run = temp_file(opt.temp_dir);
+        merge(runs, b, e, run.get(), capacity);
+        next.push_back(std::move(run));
+      }
+      runs = std::move(next);
+    }
+    File out = open(output, "wb");
+    merge(runs, 0, runs.size(), out.get(), capacity);
+    close(std::move(out), output);
+  }
+
+ private:
+  // buffered sequential reader of records
+  class Reader {
+    FILE* f_;
+    Vector buf_;
+    size_t pos_, len_;
+
+   public:
+    Reader(FILE* f, size_t const capacity)
+        : f_{f}, buf_(capacity), pos_{0}, len_{0} {}
+
+    bool next(T& t) {
+      if (pos_ == len_) {
+        len_ = read(f_, buf_.data(), buf_.size());
+        pos_ = 0;
+        if (len_ == 0) {
+          return false;
+        }
+      }
+      t = buf_[pos_++];
+      return true;
+    }
+  };
+
+  // buffered sequential writer of records
+  class Writer {
+    FILE* f_;
+    Vector buf_;
+    size_t len_;
+
+   public:
+    Writer(FILE* f, size_t const capacity) : f_{f}, buf_(capacity), len_{0} {}
+
+    void put(T const& t) {
+      buf_[len_++] = t;
+      if (len_ == buf_.size()) {
+        flush();
+      }
+    }
+
+    void flush() {
+      write(f_, buf_.data(), len_);
+      len_ = 0;
+    }
+  };
+
+  // merge `runs[b..e)` into `out`, closing the merged runs
+  static void merge(std::vector<File>& runs,
+                    size_t const b,
+                    size_t const e,
+                    FILE* out,
+                    size_t const capacity) {
+    size_t const k = e - b;
+    size_t const share = capacity / (k + 1);
+    std::vector<Reader> readers;
+    readers.reserve(k);
+    LoserTree<T, cmp> tree(k);
+    T t;
+    for (size_t i = 0; i < k; i++) {
+      std::rewind(runs[b + i].get());
+      readers.emplace_back(runs[b + i].get(), share);
+      if (readers[i].next(t)) {
+        tree.set(i, std::move(t));
+      }
+    }
+    tree.build();
+
+    Writer writer(out, share);
+    while (!tree.empty()) {
+      size_t const s = tree.top();
+      writer.put(tree.min());
+      if (readers[s].next(t)) {
+        tree.replace(std::move(t));
+      } else {
+        tree.pop();
+      }
+    }
+    writer.flush();
+    readers.clear();
+    for (size_t i = b; i < e; i++) {
+      runs[i].reset();
+    }
+  }
+
+  static File open(std::string const& path, char const* mode) {
+    FILE* f = std::fopen(path.c_str(), mode);
+    if (f == nullptr) {
+      throw std::runtime_error("External sort: cannot open " + path);
+    }
+    // buffering is done here with much larger buffers
+    std::setvbuf(f, nullptr, _IONBF, 0);
+    return File(f);
+  }
+
+  static void close(File f, std::string const& path) {
+    if (std::fclose(f.release()) != 0) {
+      throw std::runtime_error("External sort: cannot write " + path);
+    }
+  }
+
+  // anonymous file, removed from the directory at once
+  static File temp_file(std::string const& dir) {
+    std::string path = dir + "/alg_external_XXXXXX";
+    int const fd = ::mkstemp(path.data());
+    if (fd < 0) {
+      throw std::runtime_error(
+          "External sort: cannot create temporary file in " + dir);
+    }
+    ::unlink(path.c_str());
+    FILE* f = ::fdopen(fd, "w+b");
+    if (f == nullptr) {
+      ::close(fd);
+      throw std::runtime_error(
+          "External sort: cannot create temporary file in " + dir);
+    }
+    std::setvbuf(f, nullptr, _IONBF, 0);
+    return File(f);
+  }
+
+  // up to `n` records, fewer only at the end of file
+  static size_t read(FILE* f, T* p, size_t const n) {
+    size_t const bytes = std::fread(p, 1, n * sizeof(T), f);
+    if (std::ferror(f)) {
+      throw std::runtime_error("External sort: read error");
+    }
+    if (bytes % sizeof(T) != 0) {
+      throw std::runtime_error(
+          "External sort: file size is not a multiple of the record size");
+    }
+    return bytes / sizeof(T);
+  }
+
+  static void write(FILE* f, T const* p, size_t const n) {
+    if (std::fwrite(p, sizeof(T), n, f) != n) {
+      throw std::runtime_error("External sort: write error");
+    }
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_EXTERNAL_HPP__
@@ -1,52 +1,70 @@
 #ifndef __ALG_SORT_HEAP_HPP__
 #define __ALG_SORT_HEAP_HPP__
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "sort/common.hpp"
+#include "sort/radix.hpp"
 
 namespace alg {
-template <typename T, bool (*cmp)(T const& t1, T const& t2) = Order<T>::less>
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
 class Heap {
   using Vector = std::vector<T>;
 
  public:
   static void sort(Vector& a) {
-    size_t n = a.size();
+    if (!a.empty()) {
+      sort(a, 0, a.size() - 1);
+    }
+  }
+
+  // sort `a[lo..hi]`, the heap rooted at `a[lo]`
+  static void sort(Vector& a, size_t const lo, size_t const hi) {
+    size_t n = hi - lo + 1;
     // build max heap
     for (size_t k = n / 2; k >= 1; k--) {
-      sink(a, k, n);
+      sink(a, lo, k, n);
     }
     // remove the max val from `pq`
     // rebuild heap for the rest
     while (n > 1) {
-      std::swap(a[0], a[n - 1]);
+      std::swap(a[lo], a[lo + n - 1]);
       n--;
-      sink(a, 1, n);
+      sink(a, lo, 1, n);
     }
   }
 
  private:
-  static void sink(Vector& a, size_t const k_, size_t const n) {
+  static void sink(Vector& a,
+                   size_t const lo,
+                   size_t const k_,
+                   size_t const n) {
     size_t k = k_;
     while (k * 2 <= n) {
       size_t j = k * 2;
       // choosing the bigger one
-      if (j < n && cmp(a[j - 1], a[j])) {
+      if (j < n && cmp(a[lo + j - 1], a[lo + j])) {
         j++;
       }
       // until parent no less than child
-      if (!cmp(a[k - 1], a[j - 1])) {
+      if (!cmp(a[lo + k - 1], a[lo + j - 1])) {
         break;
       }
-      std::swap(a[k - 1], a[j - 1]);
+      std::swap(a[lo + k - 1], a[lo + j - 1]);
       k = j;
     }
   }
 };
 
-template <typename T, bool (*cmp)(T const& t1, T const& t2) = Order<T>::less>
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
 class PriorityQueue {
   using Vector = std::vector<T>;
 
@@ -86,6 +104,24 @@ class PriorityQueue {
     return r;
   }
 
+  T const& top() const {
+    if (pq_.empty()) {
+      throw std::runtime_error("error getting top: PQ is null");
+    }
+    return pq_[0];
+  }
+
+  // pop then push `x`, with a single sink
+  T replace(T const& x) {
+    if (pq_.empty()) {
+      throw std::runtime_error("error replacing: PQ is null");
+    }
+    T const r = pq_[0];
+    pq_[0] = x;
+    sink(1);
+    return r;
+  }
+
  private:
   void swim(size_t const k_) {
     // for each `child`, check with its `parent`
@@ -122,6 +158,652 @@ class PriorityQueue {
     }
   }
 };
+
+/*
+ * streaming top-k
+ * keeps the `k` greatest items pushed so far (by `cmp`) in a bounded
+ * `PriorityQueue` rooted at the least of them: an item out of the top costs a
+ * single compare with the root, one entering it a single sink. `O(k)` memory
+ * whatever the length of the stream. `k` smallest with `Order<T>::greater`.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class TopK {
+  using Vector = std::vector<T>;
+
+  size_t k_;
+  PriorityQueue<T, cmp> pq_;
+
+ public:
+  explicit TopK(size_t const k) : k_{k} {}
+
+  size_t size() const { return pq_.size(); }
+
+  void push(T const& x) {
+    if (pq_.size() < k_) {
+      pq_.push(x);
+    } else if (k_ > 0 && cmp(pq_.top(), x)) {
+      pq_.replace(x);
+    }
+  }
+
+  // the least item of the top, to be beaten by a new one
+  T const& threshold() const { return pq_.top(); }
+
+  // the top items, greatest first
+  Vector items() const {
+    PriorityQueue<T, cmp> pq = pq_;
+    Vector r(pq.size());
+    for (size_t i = r.size(); i > 0; i--) {
+      r[i - 1] = pq.pop();
+    }
+    return r;
+  }
+};
+
+/*
+ * d-ary heap
+ * `D` children per node, 0-based: the children of `i` are
+ * `D * i + 1 .. D * i + D`, its parent `(i - 1) / D`. with `D = 4` the
+ * children of a node are contiguous, a cache line or two for small keys, and
+ * the tree is half as deep as a binary one: fewer lines are touched per
+ * `pop`, and `push` swims half as far.
+ *
+ * items are moved, never copied: a sift carries the moving item in hand and
+ * shifts the others into the hole, which also makes move-only types usable.
+ * the root is the least item by `cmp`.
+ */
+template <typename T, auto cmp = Order<T>::less, size_t D = 4>
+  requires Comparator<decltype(cmp), T> && (D >= 2)
+class DaryHeap {
+  using Vector = std::vector<T>;
+
+  Vector heap_;
+
+ public:
+  DaryHeap() = default;
+
+  // heapify in linear time
+  explicit DaryHeap(Vector keys) : heap_(std::move(keys)) {
+    size_t const n = heap_.size();
+    for (size_t i = n < 2 ? 0 : (n - 2) / D + 1; i > 0; i--) {
+      sink(i - 1, std::move(heap_[i - 1]));
+    }
+  }
+
+  size_t size() const { return heap_.size(); }
+
+  bool empty() const { return heap_.empty(); }
+
+  T const& top() const {
+    if (heap_.empty()) {
+      throw std::runtime_error("error getting top: heap is empty");
+    }
+    return heap_[0];
+  }
+
+  void push(T x) {
+    heap_.push_back(std::move(x));
+    swim(heap_.size() - 1);
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    heap_.emplace_back(std::forward<Args>(args)...);
+    swim(heap_.size() - 1);
+  }
+
+  T pop() {
+    if (heap_.empty()) {
+      throw std::runtime_error("error popping: heap is empty");
+    }
+    T r = std::move(heap_[0]);
+    T last = std::move(heap_.back());
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      sink(0, std::move(last));
+    }
+    return r;
+  }
+
+ private:
+  void swim(size_t i) {
+    T x = std::move(heap_[i]);
+    while (i > 0) {
+      size_t const p = (i - 1) / D;
+      if (!cmp(x, heap_[p])) {
+        break;
+      }
+      heap_[i] = std::move(heap_[p]);
+      i = p;
+    }
+    heap_[i] = std::move(x);
+  }
+
+  // put `x` into the hole at `i`, then down to its place
+  void sink(size_t i, T x) {
+    size_t const n = heap_.size();
+    while (D * i + 1 < n) {
+      size_t const best = least_child(D * i + 1, n);
+      if (!cmp(heap_[best], x)) {
+        break;
+      }
+      heap_[i] = std::move(heap_[best]);
+      i = best;
+    }
+    heap_[i] = std::move(x);
+  }
+
+  // least of the children from `c`. a full set of children is compared
+  // unrolled, each compare a branch: selecting without a branch would make
+  // the address of the next level wait for the compares, and a deep heap
+  // then stalls on every cache miss in turn.
+  size_t least_child(size_t const c, size_t const n) const {
+    size_t best = c;
+    if (c + D <= n) {
+      [&]<size_t... J>(std::index_sequence<J...>) {
+        ((cmp(heap_[c + J + 1], heap_[best]) && (best = c + J + 1, true)),
+         ...);
+      }(std::make_index_sequence<D - 1>{});
+    } else {
+      for (size_t j = c + 1; j < n; j++) {
+        if (cmp(heap_[j], heap_[best])) {
+          best = j;
+        }
+      }
+    }
+    return best;
+  }
+};
+
+/*
+ * indexed priority queue on a d-ary heap
+ * items carry an index in `[0, capacity)`, through which a queued key can be
+ * read, changed or removed in `O(log n)`: a shortest-path search decreases
+ * the key of a vertex in place instead of pushing a duplicate entry and
+ * skipping stale ones later.
+ *
+ * each heap slot holds the key along with its index, so the children of a
+ * node are compared without touching another array. `pos_` maps an index to
+ * its slot. the root is the least key by `cmp`.
+ */
+template <typename T, auto cmp = Order<T>::less, size_t D = 4>
+  requires Comparator<decltype(cmp), T> && (D >= 2)
+class IndexMinPQ {
+  struct Entry {
+    T key;
+    size_t index;
+  };
+
+  static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+  std::vector<Entry> heap_;
+  // slot of each index in `heap_`, `NPOS` if not queued
+  std::vector<size_t> pos_;
+
+ public:
+  explicit IndexMinPQ(size_t const capacity) : pos_(capacity, NPOS) {}
+
+  size_t capacity() const { return pos_.size(); }
+
+  size_t size() const { return heap_.size(); }
+
+  bool empty() const { return heap_.empty(); }
+
+  bool contains(size_t const i) const {
+    check(i);
+    return pos_[i] != NPOS;
+  }
+
+  void push(size_t const i, T key) {
+    if (contains(i)) {
+      throw std::runtime_error("IndexMinPQ error: index already queued");
+    }
+    pos_[i] = heap_.size();
+    heap_.push_back(Entry{std::move(key), i});
+    swim(heap_.size() - 1);
+  }
+
+  T const& key(size_t const i) const { return heap_[slot(i)].key; }
+
+  // index of the least key
+  size_t top() const {
+    if (heap_.empty()) {
+      throw std::runtime_error("IndexMinPQ error: queue is empty");
+    }
+    return heap_[0].index;
+  }
+
+  T const& top_key() const { return key(top()); }
+
+  // remove the least key, return its index
+  size_t pop() {
+    size_t const i = top();
+    erase(i);
+    return i;
+  }
+
+  void change_key(size_t const i, T key) {
+    size_t const h = slot(i);
+    heap_[h].key = std::move(key);
+    fix(h);
+  }
+
+  // the new key must be no greater than the queued one
+  void decrease_key(size_t const i, T key) {
+    size_t const h = slot(i);
+    if (cmp(heap_[h].key, key)) {
+      throw std::runtime_error(
+          "IndexMinPQ error: decreasing to a greater key");
+    }
+    heap_[h].key = std::move(key);
+    swim(h);
+  }
+
+  // the new key must be no less than the queued one
+  void increase_key(size_t const i, T key) {
+    size_t const h = slot(i);
+    if (cmp(key, heap_[h].key)) {
+      throw std::runtime_error("IndexMinPQ error: increasing to a less key");
+    }
+    heap_[h].key = std::move(key);
+    sink(h);
+  }
+
+  void erase(size_t const i) {
+    size_t const h = slot(i);
+    pos_[i] = NPOS;
+    if (h + 1 < heap_.size()) {
+      place(h, std::move(heap_.back()));
+      heap_.pop_back();
+      fix(h);
+    } else {
+      heap_.pop_back();
+    }
+  }
+
+ private:
+  void check(size_t const i) const {
+    if (i >= pos_.size()) {
+      throw std::runtime_error("IndexMinPQ error: index out of range");
+    }
+  }
+
+  size_t slot(size_t const i) const {
+    if (!contains(i)) {
+      throw std::runtime_error("IndexMinPQ error: index not queued");
+    }
+    return pos_[i];
+  }
+
+  void place(size_t const h, Entry&& e) {
+    heap_[h] = std::move(e);
+    pos_[heap_[h].index] = h;
+  }
+
+  // restore the order after the key at `h` changed either way
+  void fix(size_t const h) {
+    if (h > 0 && cmp(heap_[h].key, heap_[(h - 1) / D].key)) {
+      swim(h);
+    } else {
+      sink(h);
+    }
+  }
+
+  void swim(size_t h) {
+    Entry e = std::move(heap_[h]);
+    while (h > 0) {
+      size_t const p = (h - 1) / D;
+      if (!cmp(e.key, heap_[p].key)) {
+        break;
+      }
+      place(h, std::move(heap_[p]));
+      h = p;
+    }
+    place(h, std::move(e));
+  }
+
+  void sink(size_t h) {
+    Entry e = std::move(heap_[h]);
+    size_t const n = heap_.size();
+    while (D * h + 1 < n) {
+      size_t const best = least_child(D * h + 1, n);
+      if (!cmp(heap_[best].key, e.key)) {
+        break;
+      }
+      place(h, std::move(heap_[best]));
+      h = best;
+    }
+    place(h, std::move(e));
+  }
+
+  // least of the children from `c`, unrolled branches as in `DaryHeap`
+  size_t least_child(size_t const c, size_t const n) const {
+    size_t best = c;
+    if (c + D <= n) {
+      [&]<size_t... J>(std::index_sequence<J...>) {
+        ((cmp(heap_[c + J + 1].key, heap_[best].key) &&
+          (best = c + J + 1, true)),
+         ...);
+      }(std::make_index_sequence<D - 1>{});
+    } else {
+      for (size_t j = c + 1; j < n; j++) {
+        if (cmp(heap_[j].key, heap_[best].key)) {
+          best = j;
+        }
+      }
+    }
+    return best;
+  }
+};
+
+/*
+ * pairing heap
+ * a heap-ordered multiway tree kept as child / next-sibling links. `push`,
+ * `meld` and `decrease_key` are a single link of two roots, `O(1)`; `pop`
+ * pairs up the children of the root left to right, then melds the pairs
+ * right to left, `O(log n)` amortized.
+ *
+ * `push` returns a handle to the item, valid until the item is popped, for
+ * `key` and `decrease_key`. handles of a heap melded into another stay valid
+ * in that other heap. the root is the least item by `cmp`.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class PairingHeap {
+  struct Node {
+    T key;
+    Node* child = nullptr;
+    Node* next = nullptr;
+    // parent of a first child, left sibling of the others
+    Node* prev = nullptr;
+  };
+
+  Node* root_ = nullptr;
+  size_t size_ = 0;
+
+ public:
+  class Handle {
+    friend class PairingHeap;
+    Node* node_ = nullptr;
+    explicit Handle(Node* node) : node_{node} {}
+
+   public:
+    Handle() = default;
+  };
+
+  PairingHeap() = default;
+
+  PairingHeap(PairingHeap const&) = delete;
+  PairingHeap& operator=(PairingHeap const&) = delete;
+
+  PairingHeap(PairingHeap&& other) noexcept
+      : root_{std::exchange(other.root_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  PairingHeap& operator=(PairingHeap&& other) noexcept {
+    if (this != &other) {
+      clear();
+      root_ = std::exchange(other.root_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~PairingHeap() { clear(); }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  T const& top() const {
+    if (root_ == nullptr) {
+      throw std::runtime_error("error getting top: heap is empty");
+    }
+    return root_->key;
+  }
+
+  Handle push(T x) {
+    Node* const n = new Node{std::move(x)};
+    root_ = root_ == nullptr ? n : link(root_, n);
+    size_++;
+    return Handle(n);
+  }
+
+  T pop() {
+    if (root_ == nullptr) {
+      throw std::runtime_error("error popping: heap is empty");
+    }
+    Node* const r = root_;
+    root_ = merge_pairs(r->child);
+    size_--;
+    T x = std::move(r->key);
+    delete r;
+    return x;
+  }
+
+  // move all items of `other` in, leaving it empty
+  void meld(PairingHeap& other) {
+    if (this == &other || other.root_ == nullptr) {
+      return;
+    }
+    root_ = root_ == nullptr ? other.root_ : link(root_, other.root_);
+    size_ += other.size_;
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+
+  T const& key(Handle const h) const { return h.node_->key; }
+
+  // the new key must be no greater than the queued one
+  void decrease_key(Handle const h, T key) {
+    Node* const n = h.node_;
+    if (cmp(n->key, key)) {
+      throw std::runtime_error(
+          "PairingHeap error: decreasing to a greater key");
+    }
+    n->key = std::move(key);
+    if (n == root_) {
+      return;
+    }
+    // cut the subtree of `n` out, then link it with the root
+    if (n->prev->child == n) {
+      n->prev->child = n->next;
+    } else {
+      n->prev->next = n->next;
+    }
+    if (n->next != nullptr) {
+      n->next->prev = n->prev;
+    }
+    n->next = n->prev = nullptr;
+    root_ = link(root_, n);
+  }
+
+  void clear() {
+    // each node is deleted after its subtrees, with no stack: a child about
+    // to be visited is detached and given its parent as next sibling
+    Node* n = root_;
+    while (n != nullptr) {
+      if (n->child != nullptr) {
+        Node* const c = n->child;
+        n->child = c->next;
+        c->next = n;
+        n = c;
+      } else {
+        Node* const next = n->next;
+        delete n;
+        n = next;
+      }
+    }
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+ private:
+  // two roots into one, the greater becoming the first child of the other
+  static Node* link(Node* a, Node* b) {
+    if (cmp(b->key, a->key)) {
+      std::swap(a, b);
+    }
+    b->next = a->child;
+    if (a->child != nullptr) {
+      a->child->prev = b;
+    }
+    b->prev = a;
+    a->child = b;
+    a->next = a->prev = nullptr;
+    return a;
+  }
+
+  // the siblings from `first` into one tree, by the two-pass pairing
+  static Node* merge_pairs(Node* first) {
+    if (first == nullptr) {
+      return nullptr;
+    }
+    // 1. link pairs left to right, stacking the winners through `next`
+    Node* pairs = nullptr;
+    while (first != nullptr) {
+      Node* const a = first;
+      Node* const b = a->next;
+      Node* w = a;
+      if (b != nullptr) {
+        first = b->next;
+        w = link(a, b);
+      } else {
+        first = nullptr;
+      }
+      w->next = pairs;
+      pairs = w;
+    }
+    // 2. meld them right to left, the last pair being on top of the stack
+    Node* r = pairs;
+    pairs = pairs->next;
+    while (pairs != nullptr) {
+      Node* const n = pairs;
+      pairs = pairs->next;
+      r = link(r, n);
+    }
+    r->next = r->prev = nullptr;
+    return r;
+  }
+};
+
+/*
+ * monotone radix heap
+ * a queue for keys popped in non-decreasing order, as the distances settled
+ * by Dijkstra's algorithm with non-negative weights: a pushed key must be no
+ * less than the last popped one.
+ *
+ * keys are mapped to unsigned integers by `RadixBits`, and an item is kept
+ * in bucket `bit_width(k ^ last)`, where `last` is the last popped key:
+ * bucket 0 holds keys equal to `last`, bucket `b` those differing from it
+ * first at bit `b - 1`. when bucket 0 runs dry, the least key of the lowest
+ * non-empty bucket becomes `last`, and every item of that bucket drops to a
+ * lower one. an item moves down at most `WIDTH` times, so `pop` costs
+ * `O(WIDTH)` amortized with no compare between items at all.
+ *
+ * `key` maps an item to its `RadixKey`, the item itself by default; e.g.
+ * `[](std::pair<uint32_t, size_t> const& p) { return p.first; }` for
+ * (distance, vertex) pairs.
+ */
+template <typename T,
+          auto key = [](T const& t) { return t; }>
+  requires RadixKey<std::invoke_result_t<decltype(key), T const&>>
+class RadixHeap {
+  using Key = std::invoke_result_t<decltype(key), T const&>;
+  using Bits = typename RadixBits<Key>::Bits;
+
+  static constexpr size_t WIDTH = RadixBits<Key>::WIDTH;
+
+  struct Entry {
+    Bits bits;
+    T item;
+  };
+
+  // bucket `b` for items whose bits differ from `last_` first at `b - 1`
+  std::vector<Entry> buckets_[WIDTH + 1];
+  // bit `b - 1` set when bucket `b` is not empty
+  uint64_t nonempty_ = 0;
+  Bits last_ = 0;
+  size_t size_ = 0;
+
+ public:
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  // the least item, found by a scan of its bucket unless it is the last
+  // popped key again
+  T const& top() const {
+    if (size_ == 0) {
+      throw std::runtime_error("error getting top: heap is empty");
+    }
+    if (!buckets_[0].empty()) {
+      return buckets_[0].back().item;
+    }
+    return least(buckets_[lowest()])->item;
+  }
+
+  void push(T x) {
+    Bits const bits = RadixBits<Key>::encode(key(x));
+    if (bits < last_) {
+      throw std::runtime_error(
+          "RadixHeap error: key less than the last popped one");
+    }
+    put(bits, std::move(x));
+    size_++;
+  }
+
+  T pop() {
+    if (size_ == 0) {
+      throw std::runtime_error("error popping: heap is empty");
+    }
+    if (buckets_[0].empty()) {
+      redistribute();
+    }
+    T x = std::move(buckets_[0].back().item);
+    buckets_[0].pop_back();
+    size_--;
+    return x;
+  }
+
+ private:
+  void put(Bits const bits, T&& x) {
+    size_t const b = std::bit_width(static_cast<Bits>(bits ^ last_));
+    if (b > 0) {
+      nonempty_ |= uint64_t(1) << (b - 1);
+    }
+    buckets_[b].push_back(Entry{bits, std::move(x)});
+  }
+
+  size_t lowest() const { return std::countr_zero(nonempty_) + 1; }
+
+  static Entry const* least(std::vector<Entry> const& bucket) {
+    Entry const* m = bucket.data();
+    for (Entry const& e : bucket) {
+      if (e.bits < m->bits) {
+        m = &e;
+      }
+    }
+    return m;
+  }
+
+  // the least key of the lowest bucket becomes `last_`, all of that bucket
+  // goes down: bits above `b - 1` agree with the new `last_` as with the old
+  void redistribute() {
+    size_t const b = lowest();
+    std::vector<Entry> bucket = std::move(buckets_[b]);
+    buckets_[b].clear();
+    nonempty_ &= ~(uint64_t(1) << (b - 1));
+    last_ = least(bucket)->bits;
+    for (Entry& e : bucket) {
+      put(e.bits, std::move(e.item));
+    }
+    // keep the capacity of the bucket for its next fill
+    bucket.clear();
+    buckets_[b] = std::move(bucket);
+  }
+};
 };  // namespace alg
 
 #endif  // !__ALG_SORT_HEAP_HPP__
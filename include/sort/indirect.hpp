@@ -0,0 +1,164 @@
+#ifndef __ALG_SORT_INDIRECT_HPP__
+#define __ALG_SORT_INDIRECT_HPP__
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sort/common.hpp>
+#include <sort/quick.hpp>
+#include <sort/radix.hpp>
+
+namespace alg {
+/*
+ * 64-bit prefixes of keys in ascending order: `of(x) < of(y)` implies
+ * `x < y`. `EXACT` when equal prefixes also mean equal keys.
+ * 1. radix keys: `RadixBits` with -0.0 as +0.0, exact for integers
+ * 2. strings: the first 8 bytes, big endian, zero padded
+ */
+template <typename T>
+struct KeyPrefix {
+  static constexpr bool ENABLED = false;
+};
+
+template <RadixKey T>
+struct KeyPrefix<T> {
+  static constexpr bool ENABLED = true;
+  // NaNs of different bits compare equal
+  static constexpr bool EXACT = std::integral<T>;
+
+  static uint64_t of(T const& x) { return RadixBits<T>::encode_value(x); }
+};
+
+template <>
+struct KeyPrefix<std::string> {
+  static constexpr bool ENABLED = true;
+  static constexpr bool EXACT = false;
+
+  static uint64_t of(std::string const& s) {
+    uint64_t p = 0;
+    size_t const n = s.size() < 8 ? s.size() : 8;
+    for (size_t i = 0; i < n; i++) {
+      p |= uint64_t(static_cast<uint8_t>(s[i])) << (56 - 8 * i);
+    }
+    return p;
+  }
+};
+
+/*
+ * indirect sort
+ * sorts a permutation of indices instead of the items themselves, then
+ * moves every item once to its place. for large records, whose moves cost
+ * far more than the compares, this replaces `O(n log n)` moves by `n` plus
+ * one per cycle of the permutation.
+ *
+ * each index is sorted along with a 64-bit prefix of its key, so most
+ * compares are between two integers in the index array itself and never
+ * touch the items. a full compare by `cmp` only settles equal prefixes.
+ * the prefix is `KeyPrefix<T>` for the ascending order of `<`, or `prefix`,
+ * any `T const& -> uint64_t` with `prefix(x) < prefix(y)` implying
+ * `cmp(x, y)`. without either, every compare goes through `cmp`.
+ *
+ * stable: ties are broken by index.
+ */
+template <typename T, auto cmp = Order<T>::less, auto prefix = nullptr>
+  requires Comparator<decltype(cmp), T>
+class Indirect {
+  using Vector = std::vector<T>;
+  using Permutation = std::vector<size_t>;
+
+  static constexpr bool CUSTOM_PREFIX =
+      !std::is_same_v<decltype(prefix), std::nullptr_t>;
+  static constexpr bool BUILTIN_PREFIX =
+      !CUSTOM_PREFIX && KeyPrefix<T>::ENABLED && is_less_order<T, cmp>();
+  static constexpr bool PREFIX = CUSTOM_PREFIX || BUILTIN_PREFIX;
+
+  static constexpr bool exact() {
+    if constexpr (BUILTIN_PREFIX) {
+      return KeyPrefix<T>::EXACT;
+    } else {
+      return false;
+    }
+  }
+
+  struct Entry {
+    // prefix of the key
+    uint64_t head;
+    size_t index;
+    T const* item;
+  };
+
+  static constexpr auto entry_less = [](Entry const& x, Entry const& y) {
+    if constexpr (PREFIX) {
+      if (x.head != y.head) {
+        return x.head < y.head;
+      }
+    }
+    if constexpr (!exact()) {
+      if (cmp(*x.item, *y.item)) {
+        return true;
+      }
+      if (cmp(*y.item, *x.item)) {
+        return false;
+      }
+    }
+    return x.index < y.index;
+  };
+
+ public:
+  static void sort(Vector& a) { apply(a, argsort(a)); }
+
+  // `p` such that `a[p[0]], a[p[1]], ..` is sorted
+  static Permutation argsort(Vector const& a) {
+    size_t const n = a.size();
+    std::vector<Entry> entries(n);
+    for (size_t i = 0; i < n; i++) {
+      entries[i] = Entry{prefix_of(a[i]), i, &a[i]};
+    }
+    IntroQuickX<Entry, entry_less>::sort(entries);
+    Permutation p(n);
+    for (size_t i = 0; i < n; i++) {
+      p[i] = entries[i].index;
+    }
+    return p;
+  }
+
+  // reorder `a` to `a[p[0]], a[p[1]], ..`, following the cycles of `p`:
+  // each item is moved once, plus one move per cycle
+  static void apply(Vector& a, Permutation const& p) {
+    size_t const n = a.size();
+    std::vector<bool> done(n, false);
+    for (size_t s = 0; s < n; s++) {
+      if (done[s] || p[s] == s) {
+        continue;
+      }
+      T t = std::move(a[s]);
+      size_t i = s;
+      while (p[i] != s) {
+        a[i] = std::move(a[p[i]]);
+        done[i] = true;
+        i = p[i];
+      }
+      a[i] = std::move(t);
+      done[i] = true;
+    }
+  }
+
+ private:
+  static uint64_t prefix_of(T const& x) {
+    if constexpr (CUSTOM_PREFIX) {
+      return static_cast<uint64_t>(prefix(x));
+    } else if constexpr (BUILTIN_PREFIX) {
+      return KeyPrefix<T>::of(x);
+    } else {
+      return 0;
+    }
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_INDIRECT_HPP__
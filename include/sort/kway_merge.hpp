@@ -0,0 +1,204 @@
+#ifndef __ALG_SORT_KWAY_MERGE_HPP__
+#define __ALG_SORT_KWAY_MERGE_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <sort/common.hpp>
+#include <sort/loser_tree.hpp>
+
+namespace alg {
+/*
+ * k-way merge of sorted runs through a `LoserTree` over the heads of the
+ * runs: `log2(k)` compares per item, where a binary heap takes two per
+ * level. the tree holds pointers into the runs, so an item is copied once,
+ * to the output.
+ *
+ * stable: ties keep the order of the runs.
+ *
+ * the parallel merge cuts the output into ranges of equal size by
+ * multi-sequence selection, and each range is merged by its own tree. the
+ * cut at rank `r` takes `s[i]` items from run `i`, with the `s[i]` summing to
+ * `r` and no item taken greater than one left, ties going to the earlier
+ * run. it is found by narrowing a window `[lo[i], hi[i]]` of each `s[i]`:
+ * the weighted median of the middle items of the windows is ranked in every
+ * run by binary search, and all windows shrink to one side of it, at least
+ * a quarter of their total each round.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class KWayMerge {
+  using Vector = std::vector<T>;
+  using Run = std::span<T const>;
+
+  // least items per range of a parallel merge
+  static constexpr size_t PARALLEL_CUTOFF = 1 << 16;
+
+  static constexpr auto head_less = [](T const* const x, T const* const y) {
+    return cmp(*x, *y);
+  };
+
+ public:
+  static Vector merge(std::vector<Vector> const& runs) {
+    std::vector<Run> const r = spans(runs);
+    Vector out(total(r));
+    merge(r, out.data());
+    return out;
+  }
+
+  static Vector merge(std::vector<Vector> const& runs, Scheduler& sched) {
+    std::vector<Run> const r = spans(runs);
+    Vector out(total(r));
+    merge(r, out.data(), sched);
+    return out;
+  }
+
+  // merge `runs` into `out[0, n)`, `n` their total size
+  static void merge(std::vector<Run> const& runs, T* out) {
+    size_t const k = runs.size();
+    if (k == 0) {
+      return;
+    }
+    LoserTree<T const*, head_less> tree(k);
+    for (size_t i = 0; i < k; i++) {
+      if (!runs[i].empty()) {
+        tree.set(i, runs[i].data());
+      }
+    }
+    tree.build();
+    while (!tree.empty()) {
+      size_t const s = tree.top();
+      T const* const p = tree.min();
+      *out++ = *p;
+      if (p + 1 != runs[s].data() + runs[s].size()) {
+        tree.replace(p + 1);
+      } else {
+        tree.pop();
+      }
+    }
+  }
+
+  static void merge(std::vector<Run> const& runs, T* out, Scheduler& sched) {
+    size_t const n = total(runs);
+    size_t const parts = std::min(sched.concurrency(), n / PARALLEL_CUTOFF);
+    if (parts < 2) {
+      merge(runs, out);
+      return;
+    }
+    // `cuts[t]` splits off the first `t * n / parts` items
+    std::vector<std::vector<size_t>> cuts(parts + 1);
+    cuts[0].assign(runs.size(), 0);
+    for (size_t i = 0; i < runs.size(); i++) {
+      cuts[parts].push_back(runs[i].size());
+    }
+    TaskGroup tg(sched);
+    for (size_t t = 1; t < parts; t++) {
+      tg.run([&, t] { cuts[t] = select(runs, t * n / parts); });
+    }
+    tg.wait();
+    for (size_t t = 0; t < parts; t++) {
+      tg.run([&, t] {
+        std::vector<Run> part;
+        for (size_t i = 0; i < runs.size(); i++) {
+          part.push_back(
+              runs[i].subspan(cuts[t][i], cuts[t + 1][i] - cuts[t][i]));
+        }
+        merge(part, out + t * n / parts);
+      });
+    }
+    tg.wait();
+  }
+
+  // items taken from each run by the first `r` of the merge
+  static std::vector<size_t> select(std::vector<Run> const& runs,
+                                    size_t const r) {
+    size_t const k = runs.size();
+    size_t const n = total(runs);
+    std::vector<size_t> lo(k), hi(k);
+    for (size_t i = 0; i < k; i++) {
+      size_t const len = runs[i].size();
+      hi[i] = std::min(len, r);
+      lo[i] = r > n - len ? r - (n - len) : 0;
+    }
+    // middle items of the windows, by run
+    std::vector<size_t> mid;
+    std::vector<size_t> cut(k);
+    while (true) {
+      mid.clear();
+      size_t weight = 0;
+      for (size_t i = 0; i < k; i++) {
+        if (lo[i] < hi[i]) {
+          mid.push_back(i);
+          weight += hi[i] - lo[i];
+        }
+      }
+      if (mid.empty()) {
+        return lo;
+      }
+      auto const item = [&](size_t const i) -> T const& {
+        return runs[i][lo[i] + (hi[i] - lo[i]) / 2];
+      };
+      std::sort(mid.begin(), mid.end(), [&](size_t const i, size_t const j) {
+        return cmp(item(i), item(j)) || (!cmp(item(j), item(i)) && i < j);
+      });
+      size_t j = mid.back();
+      for (size_t w = 0, q = 0; q < mid.size(); q++) {
+        w += hi[mid[q]] - lo[mid[q]];
+        if (2 * w >= weight) {
+          j = mid[q];
+          break;
+        }
+      }
+      size_t const m = lo[j] + (hi[j] - lo[j]) / 2;
+      T const& pivot = runs[j][m];
+
+      // items before the pivot in each run, within the windows
+      size_t sum = 0;
+      for (size_t i = 0; i < k; i++) {
+        auto const b = runs[i].begin();
+        if (i < j) {
+          cut[i] = std::upper_bound(b + lo[i], b + hi[i], pivot, cmp) - b;
+        } else if (i > j) {
+          cut[i] = std::lower_bound(b + lo[i], b + hi[i], pivot, cmp) - b;
+        } else {
+          cut[i] = m;
+        }
+        sum += cut[i];
+      }
+      if (sum == r) {
+        return cut;
+      }
+      if (sum < r) {
+        // the pivot is taken too
+        lo = cut;
+        lo[j] = m + 1;
+      } else {
+        hi = cut;
+      }
+    }
+  }
+
+ private:
+  static std::vector<Run> spans(std::vector<Vector> const& runs) {
+    std::vector<Run> r;
+    r.reserve(runs.size());
+    for (Vector const& v : runs) {
+      r.emplace_back(v);
+    }
+    return r;
+  }
+
+  static size_t total(std::vector<Run> const& runs) {
+    size_t n = 0;
+    for (Run const& r : runs) {
+      n += r.size();
+    }
+    return n;
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_KWAY_MERGE_HPP__
@@ -0,0 +1,113 @@
+#ifndef __ALG_SORT_LOSER_TREE_HPP__
+#define __ALG_SORT_LOSER_TREE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <sort/common.hpp>
+
+namespace alg {
+/*
+ * tournament tree of losers over the heads of `k` sorted sources, for k-way
+ * merging.
+ *
+ * every internal node keeps the loser of the match played there and
+ * `tree_[0]` the overall winner, so replacing the winner by the next key of
+ * its source replays a single leaf-to-root path: `log2(k)` compares, against
+ * about twice as many for a binary heap, and no compare between siblings.
+ *
+ * ties go to the source of the lower index, which keeps a merge of
+ * consecutive runs stable. exhausted sources lose every match.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class LoserTree {
+  // keys of leaves, live or exhausted
+  std::vector<T> keys_;
+  // bytes, not `std::vector<bool>` bits, read on every match
+  std::vector<uint8_t> live_;
+  // `tree_[0]` the winner, `tree_[1..k-1]` the losers of internal nodes
+  std::vector<size_t> tree_;
+  size_t k_;
+
+ public:
+  explicit LoserTree(size_t const k)
+      : keys_(k), live_(k, false), tree_(k, 0), k_{k} {
+    if (k == 0) {
+      throw std::runtime_error("LoserTree: no source to merge");
+    }
+  }
+
+  size_t sources() const { return k_; }
+
+  // head of source `i`, set before `build`. sources never set are exhausted.
+  void set(size_t const i, T key) {
+    keys_[i] = std::move(key);
+    live_[i] = true;
+  }
+
+  // play all matches from the leaves up
+  void build() {
+    // winners of the subtrees, leaf `i` at node `k + i`
+    std::vector<size_t> up(2 * k_);
+    for (size_t i = 0; i < k_; i++) {
+      up[k_ + i] = i;
+    }
+    for (size_t n = k_ - 1; n >= 1; n--) {
+      size_t const a = up[2 * n], b = up[2 * n + 1];
+      up[n] = winner(a, b);
+      tree_[n] = a ^ b ^ up[n];
+    }
+    tree_[0] = up[1];
+  }
+
+  // all sources exhausted
+  bool empty() const { return !live_[tree_[0]]; }
+
+  // source of the least key
+  size_t top() const { return tree_[0]; }
+
+  // the least key
+  T const& min() const { return keys_[tree_[0]]; }
+
+  // replace the least key by the next one of the same source
+  void replace(T key) {
+    keys_[tree_[0]] = std::move(key);
+    replay(tree_[0]);
+  }
+
+  // the source of the least key is exhausted
+  void pop() {
+    live_[tree_[0]] = false;
+    replay(tree_[0]);
+  }
+
+ private:
+  // the winner of leaves `a` and `b`, in a single compare: the lower index
+  // wins unless strictly greater. picked without branching on the keys.
+  size_t winner(size_t const a, size_t const b) const {
+    size_t const lo = a < b ? a : b, hi = a ^ b ^ lo;
+    if (!(live_[a] & live_[b])) {
+      return live_[lo] ? lo : (live_[hi] ? hi : lo);
+    }
+    size_t const hi_wins = cmp(keys_[hi], keys_[lo]);
+    return lo ^ ((lo ^ hi) & (0 - hi_wins));
+  }
+
+  void replay(size_t const i) {
+    size_t w = i;
+    for (size_t n = (k_ + i) / 2; n >= 1; n /= 2) {
+      size_t const other = tree_[n];
+      size_t const next = winner(other, w);
+      tree_[n] = other ^ w ^ next;
+      w = next;
+    }
+    tree_[0] = w;
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_LOSER_TREE_HPP__
@@ -1,70 +1,287 @@
 #ifndef __ALG_SORT_MERGE_HPP__
 #define __ALG_SORT_MERGE_HPP__
 
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <parallel/scheduler.hpp>
 #include <sort/common.hpp>
+#include <sort/network.hpp>
 
 namespace alg {
-template <typename T, bool (*cmp)(T const& t1, T const& t2) = Order<T>::less>
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
 /*
  * merge sort
+ * small subarrays of integers in ascending order go to a sorting network:
+ * equal integers can not be told apart, so stability is kept
+ *
+ * items are moved, never copied: each level merges from one array into the
+ * other, and the scratch array starts out with default values rather than a
+ * copy of the input. a scratch array passed by the caller is reused across
+ * calls. two halves already in order are moved across without a merge.
  */
 class Merge {
   using Vector = std::vector<T>;
 
  public:
   static void sort(Vector& a) {
+    Vector aux;
+    sort(a, aux);
+  }
+
+  // `aux` as scratch, grown to the size of `a` if shorter
+  static void sort(Vector& a, Vector& aux) {
     if (a.empty()) {
       return;
     }
-    Vector aux(a);
+    if (aux.size() < a.size()) {
+      aux.resize(a.size());
+    }
     sort(a, aux, 0, a.size() - 1);
   }
 
- private:
+ protected:
+  static constexpr bool NETWORK = Network<T>::ENABLED &&
+                                  std::is_integral_v<T> &&
+                                  is_less_order<T, cmp>();
+  static constexpr size_t NETWORK_CUTOFF = 32;
+
+  // sort `a[lo..hi]` in place, `aux[lo..hi]` as scratch
   static void sort(Vector& a, Vector& aux, size_t const lo, size_t const hi) {
     if (hi <= lo) {
       return;
     }
+    if constexpr (NETWORK) {
+      if (hi - lo + 1 <= NETWORK_CUTOFF) {
+        Network<T>::sort(a, lo, hi);
+        return;
+      }
+    }
     size_t const mid = lo + (hi - lo) / 2;
-    // switch the role of `a` and `aux` to avoid extra copy at each pass
-    sort(aux, a, lo, mid);
-    sort(aux, a, mid + 1, hi);
+    sort_to(a, aux, lo, mid);
+    sort_to(a, aux, mid + 1, hi);
     merge(a, aux, lo, mid, hi);
   }
 
-  static void merge(Vector& a,
-                    Vector& aux,
+  // sort `a[lo..hi]` into `aux[lo..hi]`, leaving `a[lo..hi]` moved from
+  static void sort_to(Vector& a,
+                      Vector& aux,
+                      size_t const lo,
+                      size_t const hi) {
+    if constexpr (NETWORK) {
+      if (hi - lo + 1 <= NETWORK_CUTOFF) {
+        Network<T>::sort(a, lo, hi);
+        std::move(a.begin() + lo, a.begin() + hi + 1, aux.begin() + lo);
+        return;
+      }
+    }
+    if (hi == lo) {
+      aux[lo] = std::move(a[lo]);
+      return;
+    }
+    size_t const mid = lo + (hi - lo) / 2;
+    sort(a, aux, lo, mid);
+    sort(a, aux, mid + 1, hi);
+    merge(aux, a, lo, mid, hi);
+  }
+
+  // merge the sorted runs `src[lo..mid]` and `src[mid+1..hi]` into `dst`
+  static void merge(Vector& dst,
+                    Vector& src,
                     size_t const lo,
                     size_t const mid,
                     size_t const hi) {
+    if (!cmp(src[mid + 1], src[mid])) {
+      std::move(src.begin() + lo, src.begin() + hi + 1, dst.begin() + lo);
+      return;
+    }
     size_t i = lo, j = mid + 1;
     for (size_t k = lo; k <= hi; k++) {
       if (i > mid) {
-        a[k] = aux[j++];
+        dst[k] = std::move(src[j++]);
       } else if (j > hi) {
-        a[k] = aux[i++];
-      } else if (cmp(aux[j], aux[i])) {
-        a[k] = aux[j++];
+        dst[k] = std::move(src[i++]);
+      } else if (cmp(src[j], src[i])) {
+        dst[k] = std::move(src[j++]);
       } else {
-        a[k] = aux[i++];
+        dst[k] = std::move(src[i++]);
       }
     }
   }
 };
 
+/*
+ * merge sort: task parallel
+ * the two halves are sorted as parallel tasks, and each merge wider than
+ * `PARALLEL_CUTOFF` is cut into independent chunks by co-ranking: the first
+ * `k` items of the merged run are the first `i` items of the left run plus
+ * the first `k - i` items of the right one, `i` found by binary search.
+ * ties always go to the left run, so the sort stays stable.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class ParallelMerge : Merge<T, cmp> {
+  using Vector = std::vector<T>;
+  using Base = Merge<T, cmp>;
+
+ public:
+  static void sort(Vector& a, Scheduler& sched = Scheduler::instance()) {
+    Vector aux;
+    sort(a, aux, sched);
+  }
+
+  // `aux` as scratch, grown to the size of `a` if shorter
+  static void sort(Vector& a,
+                   Vector& aux,
+                   Scheduler& sched = Scheduler::instance()) {
+    if (a.empty()) {
+      return;
+    }
+    if (aux.size() < a.size()) {
+      aux.resize(a.size());
+    }
+    sort(a, aux, 0, a.size() - 1, sched);
+  }
+
+ private:
+  static constexpr size_t PARALLEL_CUTOFF = 1 << 13;
+
+  // in place, as `Merge::sort`
+  static void sort(Vector& a,
+                   Vector& aux,
+                   size_t const lo,
+                   size_t const hi,
+                   Scheduler& sched) {
+    if (hi - lo + 1 <= PARALLEL_CUTOFF) {
+      Base::sort(a, aux, lo, hi);
+      return;
+    }
+    size_t const mid = lo + (hi - lo) / 2;
+    TaskGroup tg(sched);
+    tg.run([&] { sort_to(a, aux, lo, mid, sched); });
+    sort_to(a, aux, mid + 1, hi, sched);
+    tg.wait();
+    merge(a, aux, lo, mid, hi, sched);
+  }
+
+  // into `aux`, as `Merge::sort_to`
+  static void sort_to(Vector& a,
+                      Vector& aux,
+                      size_t const lo,
+                      size_t const hi,
+                      Scheduler& sched) {
+    if (hi - lo + 1 <= PARALLEL_CUTOFF) {
+      Base::sort_to(a, aux, lo, hi);
+      return;
+    }
+    size_t const mid = lo + (hi - lo) / 2;
+    TaskGroup tg(sched);
+    tg.run([&] { sort(a, aux, lo, mid, sched); });
+    sort(a, aux, mid + 1, hi, sched);
+    tg.wait();
+    merge(aux, a, lo, mid, hi, sched);
+  }
+
+  static void merge(Vector& dst,
+                    Vector& src,
+                    size_t const lo,
+                    size_t const mid,
+                    size_t const hi,
+                    Scheduler& sched) {
+    size_t const n = hi - lo + 1;
+    size_t const chunks =
+        std::min(4 * sched.concurrency(), n / PARALLEL_CUTOFF);
+    if (chunks <= 1) {
+      Base::merge(dst, src, lo, mid, hi);
+      return;
+    }
+    // all splits are found before any item is moved out of `src`
+    std::vector<size_t> split(chunks + 1);
+    for (size_t c = 0; c <= chunks; c++) {
+      split[c] = co_rank(src, lo, mid, hi, n * c / chunks);
+    }
+    TaskGroup tg(sched);
+    for (size_t c = 0; c < chunks; c++) {
+      size_t const k0 = n * c / chunks, k1 = n * (c + 1) / chunks;
+      size_t const i0 = split[c], i1 = split[c + 1];
+      tg.run([&dst, &src, lo, mid, k0, k1, i0, i1] {
+        merge(dst, src, lo + k0, lo + i0, lo + i1, mid + 1 + k0 - i0,
+              mid + 1 + k1 - i1);
+      });
+    }
+    tg.wait();
+  }
+
+  // number of items taken from the left run `src[lo..mid]` among the first
+  // `k` items of the stable merge with the right run `src[mid+1..hi]`
+  static size_t co_rank(Vector const& src,
+                        size_t const lo,
+                        size_t const mid,
+                        size_t const hi,
+                        size_t const k) {
+    size_t const nl = mid - lo + 1, nr = hi - mid;
+    size_t l = k > nr ? k - nr : 0, r = std::min(k, nl);
+    while (l < r) {
+      size_t const i = l + (r - l) / 2;
+      size_t const j = k - i;
+      // `i` is too small when left item `i` precedes right item `j - 1`
+      if (j > 0 && !cmp(src[mid + j], src[lo + i])) {
+        l = i + 1;
+      } else {
+        r = i;
+      }
+    }
+    return l;
+  }
+
+  // merge `src[i..ie)` and `src[j..je)` into `dst` from `k` on
+  static void merge(Vector& dst,
+                    Vector& src,
+                    size_t k,
+                    size_t i,
+                    size_t const ie,
+                    size_t j,
+                    size_t const je) {
+    while (i < ie && j < je) {
+      dst[k++] = std::move(cmp(src[j], src[i]) ? src[j++] : src[i++]);
+    }
+    while (i < ie) {
+      dst[k++] = std::move(src[i++]);
+    }
+    while (j < je) {
+      dst[k++] = std::move(src[j++]);
+    }
+  }
+};
+
 /*
  * merge sort : bottom up (slower than recursive version)
+ * only the shorter run of a merge is moved out to the scratch array; the
+ * other one is merged from where it lies, front to back for a short left
+ * run and back to front for a short right one, so the scratch array never
+ * needs more than half of the input.
  */
-template <typename T, bool (*cmp)(T const& t1, T const& t2) = Order<T>::less>
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
 class MergeBU {
   using Vector = std::vector<T>;
 
  public:
   static void sort(Vector& a) {
-    Vector aux(a);
+    Vector aux;
+    sort(a, aux);
+  }
+
+  // `aux` as scratch, grown to half the size of `a` if shorter
+  static void sort(Vector& a, Vector& aux) {
     size_t const n = a.size();
+    if (aux.size() < n / 2) {
+      aux.resize(n / 2);
+    }
     for (size_t sz = 1; sz < n; sz *= 2) {
       for (size_t lo = 0; lo < n - sz; lo += 2 * sz) {
         merge(a, aux, lo, lo + sz - 1, std::min(lo + 2 * sz - 1, n - 1));
@@ -78,21 +295,405 @@ class MergeBU {
                     size_t const lo,
                     size_t const mid,
                     size_t const hi) {
-    for (size_t k = lo; k <= hi; k++) {
-      aux[k] = a[k];
+    if (!cmp(a[mid + 1], a[mid])) {
+      return;
     }
-    size_t i = lo, j = mid + 1;
-    for (size_t k = lo; k <= hi; k++) {
-      if (i > mid) {
-        a[k] = aux[j++];
-      } else if (j > hi) {
-        a[k] = aux[i++];
-      } else if (cmp(aux[j], aux[i])) {
-        a[k] = aux[j++];
+    size_t const nl = mid - lo + 1, nr = hi - mid;
+    if (nl <= nr) {
+      std::move(a.begin() + lo, a.begin() + mid + 1, aux.begin());
+      // `k` never passes `j`: the right run is read before it is overwritten
+      size_t i = 0, j = mid + 1, k = lo;
+      while (i < nl && j <= hi) {
+        a[k++] = std::move(cmp(a[j], aux[i]) ? a[j++] : aux[i++]);
+      }
+      while (i < nl) {
+        a[k++] = std::move(aux[i++]);
+      }
+    } else {
+      std::move(a.begin() + mid + 1, a.begin() + hi + 1, aux.begin());
+      // from the back, `i` and `j` one past the next items of either run;
+      // ties go to the right run, which comes last
+      size_t i = mid + 1, j = nr, k = hi + 1;
+      while (i > lo && j > 0) {
+        a[--k] = std::move(cmp(aux[j - 1], a[i - 1]) ? a[--i] : aux[--j]);
+      }
+      while (j > 0) {
+        a[--k] = std::move(aux[--j]);
+      }
+    }
+  }
+};
+
+/*
+ * merge sort : natural runs (TimSort)
+ * adaptive to existing order, close to linear time on nearly sorted input:
+ * 1. the input is cut into maximal ascending or strictly descending runs,
+ *    the latter reversed in place. runs shorter than `min_run` are extended
+ *    by binary insertion sort.
+ * 2. runs go onto a stack whose lengths grow at least like the Fibonacci
+ *    numbers from the top, which keeps merges balanced and the stack short.
+ * 3. a merge first skips the parts of both runs already in place, then
+ *    merges through a buffer as large as the shorter run. once one side
+ *    keeps winning, it switches to galloping (exponential then binary
+ *    search) to move whole blocks at once. the threshold adapts to how well
+ *    galloping pays off.
+ * stable, ties always go to the left run.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class NaturalMerge {
+  using Vector = std::vector<T>;
+
+  struct Run {
+    size_t base, len;
+  };
+
+  struct State {
+    Vector& a;
+    // buffer of the shorter run of a merge
+    Vector tmp;
+    // pending runs, from the left end of `a`
+    std::vector<Run> runs;
+    size_t min_gallop;
+  };
+
+ public:
+  static void sort(Vector& a) {
+    size_t const n = a.size();
+    if (n < 2) {
+      return;
+    }
+    State s{a, {}, {}, MIN_GALLOP};
+    size_t const min_run = min_run_length(n);
+    for (size_t lo = 0; lo < n;) {
+      size_t len = count_run(a, lo, n);
+      if (len < min_run) {
+        size_t const forced = std::min(min_run, n - lo);
+        if constexpr (NETWORK) {
+          Network<T>::sort(a, lo, lo + forced - 1);
+        } else {
+          binary_insertion(a, lo, lo + forced, lo + len);
+        }
+        len = forced;
+      }
+      s.runs.push_back({lo, len});
+      collapse(s);
+      lo += len;
+    }
+    force_collapse(s);
+  }
+
+ private:
+  static constexpr size_t MIN_MERGE = 32;
+  static constexpr size_t MIN_GALLOP = 7;
+  // short runs of integers are extended by a sorting network, see `Merge`
+  static constexpr bool NETWORK = Network<T>::ENABLED &&
+                                  std::is_integral_v<T> &&
+                                  is_less_order<T, cmp>();
+
+  // in `[MIN_MERGE / 2, MIN_MERGE]`, such that `n / min_run` is a power of
+  // two or slightly less
+  static size_t min_run_length(size_t n) {
+    size_t r = 0;
+    while (n >= MIN_MERGE) {
+      r |= n & 1;
+      n >>= 1;
+    }
+    return n + r;
+  }
+
+  // length of the run from `lo`, made ascending
+  static size_t count_run(Vector& a, size_t const lo, size_t const n) {
+    size_t hi = lo + 1;
+    if (hi == n) {
+      return 1;
+    }
+    if (cmp(a[hi++], a[lo])) {
+      // strictly, or reversing would break stability
+      while (hi < n && cmp(a[hi], a[hi - 1])) {
+        hi++;
+      }
+      std::reverse(a.begin() + lo, a.begin() + hi);
+    } else {
+      while (hi < n && !cmp(a[hi], a[hi - 1])) {
+        hi++;
+      }
+    }
+    return hi - lo;
+  }
+
+  // sort `a[lo, hi)`, of which `a[lo, start)` is already sorted
+  static void binary_insertion(Vector& a,
+                               size_t const lo,
+                               size_t const hi,
+                               size_t const start) {
+    for (size_t i = start; i < hi; i++) {
+      T pivot = std::move(a[i]);
+      auto const pos =
+          std::upper_bound(a.begin() + lo, a.begin() + i, pivot, cmp);
+      std::move_backward(pos, a.begin() + i, a.begin() + i + 1);
+      *pos = std::move(pivot);
+    }
+  }
+
+  // merge until, for the top runs `X, Y, Z` (`Z` on top),
+  // `|X| > |Y| + |Z|` and `|Y| > |Z|`. the run below `X` is checked as well,
+  // the invariant could break there otherwise.
+  static void collapse(State& s) {
+    auto const& r = s.runs;
+    while (r.size() > 1) {
+      size_t n = r.size() - 2;
+      if ((n > 0 && r[n - 1].len <= r[n].len + r[n + 1].len) ||
+          (n > 1 && r[n - 2].len <= r[n - 1].len + r[n].len)) {
+        if (r[n - 1].len < r[n + 1].len) {
+          n--;
+        }
+      } else if (r[n].len > r[n + 1].len) {
+        break;
+      }
+      merge_at(s, n);
+    }
+  }
+
+  static void force_collapse(State& s) {
+    auto const& r = s.runs;
+    while (r.size() > 1) {
+      size_t n = r.size() - 2;
+      if (n > 0 && r[n - 1].len < r[n + 1].len) {
+        n--;
+      }
+      merge_at(s, n);
+    }
+  }
+
+  // merge runs `i` and `i + 1`
+  static void merge_at(State& s, size_t const i) {
+    Vector& a = s.a;
+    Run const x = s.runs[i], y = s.runs[i + 1];
+    s.runs[i].len = x.len + y.len;
+    s.runs.erase(s.runs.begin() + i + 1);
+
+    // items of `x` no greater than the first of `y` are in place
+    size_t const k = gallop_right(a[y.base], a.data() + x.base, x.len, 0);
+    size_t const base1 = x.base + k, len1 = x.len - k;
+    if (len1 == 0) {
+      return;
+    }
+    // items of `y` no less than the last of `x` are in place
+    size_t const len2 =
+        gallop_left(a[base1 + len1 - 1], a.data() + y.base, y.len, y.len - 1);
+    if (len2 == 0) {
+      return;
+    }
+    if (s.tmp.size() < std::min(len1, len2)) {
+      s.tmp.resize(std::min(len1, len2));
+    }
+    if (len1 <= len2) {
+      merge_lo(s, base1, len1, y.base, len2);
+    } else {
+      merge_hi(s, base1, len1, y.base, len2);
+    }
+  }
+
+  // merge from the left, the left run `a[base1, base1 + len1)` in buffer
+  static void merge_lo(State& s,
+                       size_t const base1,
+                       size_t const len1,
+                       size_t const base2,
+                       size_t const len2) {
+    Vector& a = s.a;
+    Vector& tmp = s.tmp;
+    std::move(a.begin() + base1, a.begin() + base1 + len1, tmp.begin());
+    size_t c1 = 0, c2 = base2, d = base1;
+    size_t const end2 = base2 + len2;
+    size_t min_gallop = s.min_gallop;
+    while (c1 < len1 && c2 < end2) {
+      // one at a time, until a run wins `min_gallop` times in a row
+      size_t count1 = 0, count2 = 0;
+      while (c1 < len1 && c2 < end2) {
+        if (cmp(a[c2], tmp[c1])) {
+          a[d++] = std::move(a[c2++]);
+          count1 = 0;
+          if (++count2 >= min_gallop) {
+            break;
+          }
+        } else {
+          a[d++] = std::move(tmp[c1++]);
+          count2 = 0;
+          if (++count1 >= min_gallop) {
+            break;
+          }
+        }
+      }
+      // galloping, while it moves long enough blocks
+      while (c1 < len1 && c2 < end2) {
+        size_t const k1 = gallop_right(a[c2], tmp.data() + c1, len1 - c1, 0);
+        std::move(tmp.begin() + c1, tmp.begin() + c1 + k1, a.begin() + d);
+        c1 += k1;
+        d += k1;
+        if (c1 == len1) {
+          break;
+        }
+        size_t const k2 = gallop_left(tmp[c1], a.data() + c2, end2 - c2, 0);
+        std::move(a.begin() + c2, a.begin() + c2 + k2, a.begin() + d);
+        c2 += k2;
+        d += k2;
+        if (k1 < MIN_GALLOP && k2 < MIN_GALLOP) {
+          min_gallop += 2;
+          break;
+        }
+        if (min_gallop > 1) {
+          min_gallop--;
+        }
+      }
+    }
+    // what is left of the right run is in place already
+    std::move(tmp.begin() + c1, tmp.begin() + len1, a.begin() + d);
+    s.min_gallop = min_gallop;
+  }
+
+  // merge from the right, the right run `a[base2, base2 + len2)` in buffer
+  static void merge_hi(State& s,
+                       size_t const base1,
+                       size_t const len1,
+                       size_t const base2,
+                       size_t const len2) {
+    Vector& a = s.a;
+    Vector& tmp = s.tmp;
+    std::move(a.begin() + base2, a.begin() + base2 + len2, tmp.begin());
+    // one past the cursors and the destination
+    size_t c1 = base1 + len1, c2 = len2, d = base2 + len2;
+    size_t min_gallop = s.min_gallop;
+    while (c1 > base1 && c2 > 0) {
+      size_t count1 = 0, count2 = 0;
+      while (c1 > base1 && c2 > 0) {
+        if (cmp(tmp[c2 - 1], a[c1 - 1])) {
+          a[--d] = std::move(a[--c1]);
+          count2 = 0;
+          if (++count1 >= min_gallop) {
+            break;
+          }
+        } else {
+          a[--d] = std::move(tmp[--c2]);
+          count1 = 0;
+          if (++count2 >= min_gallop) {
+            break;
+          }
+        }
+      }
+      while (c1 > base1 && c2 > 0) {
+        size_t const n1 = c1 - base1;
+        size_t const k1 =
+            n1 - gallop_right(tmp[c2 - 1], a.data() + base1, n1, n1 - 1);
+        std::move_backward(a.begin() + c1 - k1, a.begin() + c1, a.begin() + d);
+        c1 -= k1;
+        d -= k1;
+        if (c1 == base1) {
+          break;
+        }
+        size_t const k2 = c2 - gallop_left(a[c1 - 1], tmp.data(), c2, c2 - 1);
+        std::move_backward(tmp.begin() + c2 - k2, tmp.begin() + c2,
+                           a.begin() + d);
+        c2 -= k2;
+        d -= k2;
+        if (k1 < MIN_GALLOP && k2 < MIN_GALLOP) {
+          min_gallop += 2;
+          break;
+        }
+        if (min_gallop > 1) {
+          min_gallop--;
+        }
+      }
+    }
+    // what is left of the left run is in place already
+    std::move(tmp.begin(), tmp.begin() + c2, a.begin() + base1);
+    s.min_gallop = min_gallop;
+  }
+
+  // number of items of sorted `p[0, len)` less than `key`, searched by
+  // galloping from `p[hint]`
+  static size_t gallop_left(T const& key,
+                            T const* p,
+                            size_t const len,
+                            size_t const hint) {
+    // `p[lo] < key <= p[hi]`, `-1` and `len` standing for the ends
+    ptrdiff_t lo, hi;
+    ptrdiff_t const h = static_cast<ptrdiff_t>(hint);
+    ptrdiff_t const n = static_cast<ptrdiff_t>(len);
+    ptrdiff_t last = 0, ofs = 1;
+    if (cmp(p[h], key)) {
+      // to the right: `p[h + last] < key <= p[h + ofs]`
+      ptrdiff_t const max = n - h;
+      while (ofs < max && cmp(p[h + ofs], key)) {
+        last = ofs;
+        ofs = 2 * ofs + 1;
+      }
+      lo = h + last;
+      hi = h + std::min(ofs, max);
+    } else {
+      // to the left: `p[h - ofs] < key <= p[h - last]`
+      ptrdiff_t const max = h + 1;
+      while (ofs < max && !cmp(p[h - ofs], key)) {
+        last = ofs;
+        ofs = 2 * ofs + 1;
+      }
+      lo = h - std::min(ofs, max);
+      hi = h - last;
+    }
+    // binary search in `(lo, hi]`
+    lo++;
+    while (lo < hi) {
+      ptrdiff_t const m = lo + (hi - lo) / 2;
+      if (cmp(p[m], key)) {
+        lo = m + 1;
+      } else {
+        hi = m;
+      }
+    }
+    return static_cast<size_t>(hi);
+  }
+
+  // number of items of sorted `p[0, len)` no greater than `key`, searched by
+  // galloping from `p[hint]`
+  static size_t gallop_right(T const& key,
+                             T const* p,
+                             size_t const len,
+                             size_t const hint) {
+    // `p[lo] <= key < p[hi]`, `-1` and `len` standing for the ends
+    ptrdiff_t lo, hi;
+    ptrdiff_t const h = static_cast<ptrdiff_t>(hint);
+    ptrdiff_t const n = static_cast<ptrdiff_t>(len);
+    ptrdiff_t last = 0, ofs = 1;
+    if (cmp(key, p[h])) {
+      // to the left: `p[h - ofs] <= key < p[h - last]`
+      ptrdiff_t const max = h + 1;
+      while (ofs < max && cmp(key, p[h - ofs])) {
+        last = ofs;
+        ofs = 2 * ofs + 1;
+      }
+      lo = h - std::min(ofs, max);
+      hi = h - last;
+    } else {
+      // to the right: `p[h + last] <= key < p[h + ofs]`
+      ptrdiff_t const max = n - h;
+      while (ofs < max && !cmp(key, p[h + ofs])) {
+        last = ofs;
+        ofs = 2 * ofs + 1;
+      }
+      lo = h + last;
+      hi = h + std::min(ofs, max);
+    }
+    // binary search in `(lo, hi]`
+    lo++;
+    while (lo < hi) {
+      ptrdiff_t const m = lo + (hi - lo) / 2;
+      if (cmp(key, p[m])) {
+        hi = m;
       } else {
-        a[k] = aux[i++];
+        lo = m + 1;
       }
     }
+    return static_cast<size_t>(hi);
   }
 };
 
@@ -0,0 +1,248 @@
+#ifndef __ALG_SORT_NETWORK_HPP__
+#define __ALG_SORT_NETWORK_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alg {
+// the kernels need `__builtin_shuffle` and `?:` on vectors, which only GCC
+// has: elsewhere `Network<T>::ENABLED` is false and the sorts keep their
+// `Insertion` base case
+#if defined(__GNUC__) && !defined(__clang__)
+/*
+ * bitonic sorting network over `N` elements held in `N / W` SIMD vectors of
+ * `W` lanes (`BYTES` bytes each), written with GCC vector extensions.
+ *
+ * every stage is a fixed sequence of lane-wise min/max, shuffles and blends,
+ * so there is no data-dependent branch at all. the "flip" form of the
+ * network is used, where all comparators point the same way:
+ * for each `k = 2, 4, .., N`
+ * 1. flip: element `i` of each block of `k` meets element `k - 1 - i`
+ * 2. half cleaners: element `i` meets `i + j`, for `j = k / 4, .., 1`
+ * a distance no less than `W` pairs whole vectors, a shorter one pairs the
+ * lanes of a vector with a shuffled copy of itself.
+ */
+template <typename T, size_t BYTES, size_t N>
+class NetworkKernel {
+  using Lane = std::conditional_t<
+      sizeof(T) <= 2,
+      std::conditional_t<sizeof(T) == 1, int8_t, int16_t>,
+      std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>;
+  typedef T V __attribute__((vector_size(BYTES)));
+  typedef Lane I __attribute__((vector_size(BYTES)));
+
+  static constexpr size_t W = BYTES / sizeof(T);
+  static constexpr size_t M = N / W;
+  static_assert(W >= 1 && N >= W && N % W == 0);
+
+ public:
+  [[gnu::always_inline]] static inline void sort(T* p) {
+    V v[M];
+    std::memcpy(v, p, sizeof(v));
+    stage<2>(v);
+    std::memcpy(p, v, sizeof(v));
+  }
+
+ private:
+  // shuffle and blend masks of a `W`-lane vector
+  template <size_t X, typename = std::make_index_sequence<W>>
+  struct Mask;
+
+  template <size_t X, size_t... L>
+  struct Mask<X, std::index_sequence<L...>> {
+    // lane `l` meets lane `l ^ X`
+    static constexpr I partner = I{static_cast<Lane>(L ^ X)...};
+    // lanes with bit `X` set, which keep the max
+    static constexpr I upper = I{static_cast<Lane>((L & X) ? -1 : 0)...};
+    static constexpr I reverse = I{static_cast<Lane>(W - 1 - L)...};
+  };
+
+  // vectors are passed by reference only: returning them from a function
+  // compiled without AVX would change the ABI
+  [[gnu::always_inline]] static inline void exchange(V& x, V& y) {
+    V const t = x;
+    x = y < t ? y : t;
+    y = y < t ? t : y;
+  }
+
+  // lane `l` against lane `l ^ X` of the same vector, max to bit `U` set
+  template <size_t X, size_t U>
+  [[gnu::always_inline]] static inline void exchange(V& x) {
+    V lo = x, hi = __builtin_shuffle(x, Mask<X>::partner);
+    exchange(lo, hi);
+    x = Mask<U>::upper ? hi : lo;
+  }
+
+  template <size_t K>
+  [[gnu::always_inline]] static inline void stage(V* v) {
+    if constexpr (K <= N) {
+      flip<K>(v);
+      clean<K / 4>(v);
+      stage<2 * K>(v);
+    }
+  }
+
+  template <size_t K>
+  [[gnu::always_inline]] static inline void flip(V* v) {
+    if constexpr (K <= W) {
+      for (size_t q = 0; q < M; q++) {
+        exchange<K - 1, K / 2>(v[q]);
+      }
+    } else {
+      // vector `q` of a block meets the reversed vector `KV - 1 - q`
+      constexpr size_t KV = K / W;
+      for (size_t b = 0; b < M; b += KV) {
+        for (size_t q = 0; q < KV / 2; q++) {
+          V y = __builtin_shuffle(v[b + KV - 1 - q], Mask<0>::reverse);
+          exchange(v[b + q], y);
+          v[b + KV - 1 - q] = __builtin_shuffle(y, Mask<0>::reverse);
+        }
+      }
+    }
+  }
+
+  template <size_t J>
+  [[gnu::always_inline]] static inline void clean(V* v) {
+    if constexpr (J >= W) {
+      constexpr size_t JV = J / W;
+      for (size_t b = 0; b < M; b += 2 * JV) {
+        for (size_t q = b; q < b + JV; q++) {
+          exchange(v[q], v[q + JV]);
+        }
+      }
+      clean<J / 2>(v);
+    } else if constexpr (J >= 1) {
+      for (size_t q = 0; q < M; q++) {
+        exchange<J, J>(v[q]);
+      }
+      clean<J / 2>(v);
+    }
+  }
+};
+#endif
+
+/*
+ * sorting networks for subarrays of up to `MAX` arithmetic keys in ascending
+ * order, meant as the base case of recursive sorts instead of `Insertion`.
+ *
+ * a subarray is padded to the next network size (8, 16, 32 or 64) with the
+ * greatest key. the kernel is picked at runtime: AVX2 (32-byte vectors),
+ * SSE4.2 (16-byte vectors) or plain scalar min/max. GCC only.
+ */
+template <typename T>
+class Network {
+  using Vector = std::vector<T>;
+
+#if defined(__GNUC__) && !defined(__clang__)
+  static constexpr bool KERNELS = true;
+#else
+  static constexpr bool KERNELS = false;
+#endif
+
+ public:
+  static constexpr bool ENABLED =
+      KERNELS && std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+      (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+  static constexpr size_t MAX = 64;
+
+  // sort `a[lo..hi]`, no longer than `MAX`
+  static void sort(Vector& a, size_t const lo, size_t const hi) {
+    sort(a.data() + lo, hi - lo + 1);
+  }
+
+  static void sort(T* p, size_t const n) {
+    static_assert(ENABLED,
+                  "sorting networks are for arithmetic keys, built by GCC");
+#if defined(__GNUC__) && !defined(__clang__)
+    if (n < 2) {
+      return;
+    }
+    if (n <= 8) {
+      run<8>(p, n);
+    } else if (n <= 16) {
+      run<16>(p, n);
+    } else if (n <= 32) {
+      run<32>(p, n);
+    } else {
+      run<MAX>(p, n);
+    }
+#endif
+  }
+
+#if defined(__GNUC__) && !defined(__clang__)
+ private:
+  enum class Isa { Scalar, Sse, Avx2 };
+
+  static Isa isa() {
+#if defined(__x86_64__) || defined(__i386__)
+    static Isa const detected =
+        __builtin_cpu_supports("avx2")     ? Isa::Avx2
+        : __builtin_cpu_supports("sse4.2") ? Isa::Sse
+                                           : Isa::Scalar;
+    return detected;
+#else
+    return Isa::Scalar;
+#endif
+  }
+
+  template <size_t N>
+  static void run(T* p, size_t const n) {
+    T buf[N];
+    std::memcpy(buf, p, n * sizeof(T));
+    T const pad = std::numeric_limits<T>::has_infinity
+                      ? std::numeric_limits<T>::infinity()
+                      : std::numeric_limits<T>::max();
+    for (size_t i = n; i < N; i++) {
+      buf[i] = pad;
+    }
+    Isa const k = isa();
+    if (k == Isa::Avx2 && N >= 32 / sizeof(T)) {
+      avx2<N>(buf);
+    } else if (k != Isa::Scalar && N >= 16 / sizeof(T)) {
+      sse<N>(buf);
+    } else {
+      scalar<N>(buf);
+    }
+    std::memcpy(p, buf, n * sizeof(T));
+  }
+
+  template <size_t N>
+  static void scalar(T* p) {
+    NetworkKernel<T, sizeof(T), N>::sort(p);
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  template <size_t N>
+  __attribute__((target("sse4.2"))) static void sse(T* p) {
+    if constexpr (N >= 16 / sizeof(T)) {
+      NetworkKernel<T, 16, N>::sort(p);
+    }
+  }
+
+  template <size_t N>
+  __attribute__((target("avx2"))) static void avx2(T* p) {
+    if constexpr (N >= 32 / sizeof(T)) {
+      NetworkKernel<T, 32, N>::sort(p);
+    }
+  }
+#else
+  template <size_t N>
+  static void sse(T* p) {
+    scalar<N>(p);
+  }
+
+  template <size_t N>
+  static void avx2(T* p) {
+    scalar<N>(p);
+  }
+#endif
+#endif
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_NETWORK_HPP__
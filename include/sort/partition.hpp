@@ -0,0 +1,301 @@
+#ifndef __ALG_SORT_PARTITION_HPP__
+#define __ALG_SORT_PARTITION_HPP__
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace alg {
+/*
+ * partition of 32 and 64 bit signed integers, floats and doubles around a
+ * pivot, a vector of keys at a time (Bramas; Blacher, Giesen and Kühne):
+ * 1. a vector is compared to the pivot in one instruction, giving a bit
+ *    mask of the keys going left
+ * 2. the keys are packed by the mask, left ones first, and the vector is
+ *    stored at both write ends: the left keys land at the left end, the
+ *    right ones at the right end. AVX2 packs with a permutation looked up
+ *    by the mask, AVX-512 with its compress instruction.
+ * the first and last vectors are set aside to start with, and a vector is
+ * read next from the side with less room, so a store never reaches keys
+ * not read yet. the keys left over are placed one by one.
+ *
+ * keys equal to the pivot go left in even lanes and right in odd ones, and
+ * so end up on both sides, as with Hoare's scans stopping on them: all equal
+ * keys still split in halves.
+ *
+ * the kernel is picked at runtime: AVX-512, AVX2 or a scalar Hoare
+ * partition. the order is ascending `<`.
+ */
+template <typename T>
+class SimdPartition {
+ public:
+  static constexpr bool ENABLED =
+      ((std::is_integral_v<T> && std::is_signed_v<T>) ||
+       std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+      (sizeof(T) == 4 || sizeof(T) == 8);
+
+  enum class Isa { Scalar, Avx2, Avx512 };
+
+  static Isa isa() {
+#if defined(__x86_64__) || defined(__i386__)
+    static Isa const detected = __builtin_cpu_supports("avx512f") ? Isa::Avx512
+                                : __builtin_cpu_supports("avx2")  ? Isa::Avx2
+                                                                  : Isa::Scalar;
+    return detected;
+#else
+    return Isa::Scalar;
+#endif
+  }
+
+  static bool supported(Isa const k) {
+    return static_cast<int>(k) <= static_cast<int>(isa());
+  }
+
+  // reorder `p[0, n)` into `p[0, m)` no greater than `pivot` and `p[m, n)`
+  // no less than it, returning `m`
+  static size_t partition(T* const p,
+                          size_t const n,
+                          T const pivot,
+                          Isa const k = isa()) {
+    static_assert(ENABLED, "vector partition is for 32 and 64 bit keys");
+    switch (k) {
+      case Isa::Avx512:
+        return avx512(p, n, pivot);
+      case Isa::Avx2:
+        return avx2(p, n, pivot);
+      case Isa::Scalar:
+        break;
+    }
+    return scalar(p, n, pivot);
+  }
+
+ private:
+  static size_t scalar(T* const p, size_t const n, T const pivot) {
+    size_t i = 0, j = n;
+    while (true) {
+      while (i < j && p[i] < pivot) {
+        i++;
+      }
+      while (i < j && pivot < p[j - 1]) {
+        j--;
+      }
+      // `p[i]`, if any, is equal to the pivot
+      if (i + 1 >= j) {
+        return i;
+      }
+      std::swap(p[i++], p[--j]);
+    }
+  }
+
+  // the keys in `rest` into the gap `p[l, r)`, which they fill
+  static size_t finish(T* const p,
+                       size_t l,
+                       size_t r,
+                       T const* const rest,
+                       size_t const m,
+                       T const pivot) {
+    for (size_t i = 0; i < m; i++) {
+      T const x = rest[i];
+      if (x < pivot || (x == pivot && i % 2 == 0)) {
+        p[l++] = x;
+      } else {
+        p[--r] = x;
+      }
+    }
+    return l;
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  // lane indices of 32 bits packing the left keys of mask `m` first, then
+  // the right ones, a byte each
+  template <size_t W>
+  static constexpr std::array<uint64_t, (size_t(1) << W)> permutations() {
+    std::array<uint64_t, (size_t(1) << W)> t{};
+    for (size_t m = 0; m < t.size(); m++) {
+      size_t k = 0;
+      for (size_t const side : {size_t(1), size_t(0)}) {
+        for (size_t l = 0; l < W; l++) {
+          if (((m >> l) & 1) != side) {
+            continue;
+          }
+          for (size_t h = 0; h < 8 / W; h++) {
+            t[m] |= static_cast<uint64_t>(l * (8 / W) + h) << (8 * k++);
+          }
+        }
+      }
+    }
+    return t;
+  }
+
+  __attribute__((target("avx2"))) static size_t avx2(T* const p,
+                                                     size_t const n,
+                                                     T const pivot) {
+    constexpr size_t W = 32 / sizeof(T);
+    static constexpr std::array<uint64_t, (size_t(1) << W)> PERMUTATIONS =
+        permutations<W>();
+    if (n < 2 * W) {
+      return scalar(p, n, pivot);
+    }
+    __m256i pv, even;
+    if constexpr (std::is_same_v<T, float>) {
+      pv = _mm256_castps_si256(_mm256_set1_ps(pivot));
+    } else if constexpr (std::is_same_v<T, double>) {
+      pv = _mm256_castpd_si256(_mm256_set1_pd(pivot));
+    } else if constexpr (sizeof(T) == 4) {
+      pv = _mm256_set1_epi32(static_cast<int32_t>(pivot));
+    } else {
+      pv = _mm256_set1_epi64x(static_cast<int64_t>(pivot));
+    }
+    if constexpr (sizeof(T) == 4) {
+      even = _mm256_setr_epi32(-1, 0, -1, 0, -1, 0, -1, 0);
+    } else {
+      even = _mm256_setr_epi64x(-1, 0, -1, 0);
+    }
+
+    T rest[3 * W];
+    std::memcpy(rest, p, W * sizeof(T));
+    std::memcpy(rest + W, p + n - W, W * sizeof(T));
+    // written `[0, lw)` and `[rw, n)`, not read yet `[lr, rr)`
+    size_t lw = 0, rw = n, lr = W, rr = n - W;
+    while (rr - lr >= W) {
+      T const* src;
+      if (lr - lw <= rw - rr) {
+        src = p + lr;
+        lr += W;
+      } else {
+        rr -= W;
+        src = p + rr;
+      }
+      __m256i const v =
+          _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src));
+      __m256i lt, eq;
+      if constexpr (std::is_same_v<T, float>) {
+        __m256 const x = _mm256_castsi256_ps(v), y = _mm256_castsi256_ps(pv);
+        lt = _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_LT_OQ));
+        eq = _mm256_castps_si256(_mm256_cmp_ps(x, y, _CMP_EQ_OQ));
+      } else if constexpr (std::is_same_v<T, double>) {
+        __m256d const x = _mm256_castsi256_pd(v), y = _mm256_castsi256_pd(pv);
+        lt = _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_LT_OQ));
+        eq = _mm256_castpd_si256(_mm256_cmp_pd(x, y, _CMP_EQ_OQ));
+      } else if constexpr (sizeof(T) == 4) {
+        lt = _mm256_cmpgt_epi32(pv, v);
+        eq = _mm256_cmpeq_epi32(v, pv);
+      } else {
+        lt = _mm256_cmpgt_epi64(pv, v);
+        eq = _mm256_cmpeq_epi64(v, pv);
+      }
+      __m256i const left = _mm256_or_si256(lt, _mm256_and_si256(eq, even));
+      uint32_t m;
+      if constexpr (sizeof(T) == 4) {
+        m = static_cast<uint32_t>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(left)));
+      } else {
+        m = static_cast<uint32_t>(
+            _mm256_movemask_pd(_mm256_castsi256_pd(left)));
+      }
+      __m256i const idx = _mm256_cvtepu8_epi32(
+          _mm_loadl_epi64(reinterpret_cast<__m128i const*>(&PERMUTATIONS[m])));
+      __m256i const packed = _mm256_permutevar8x32_epi32(v, idx);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + lw), packed);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + rw - W), packed);
+      size_t const nl = static_cast<size_t>(std::popcount(m));
+      lw += nl;
+      rw -= W - nl;
+    }
+    std::memcpy(rest + 2 * W, p + lr, (rr - lr) * sizeof(T));
+    return finish(p, lw, rw, rest, 2 * W + rr - lr, pivot);
+  }
+
+  __attribute__((target("avx512f"))) static size_t avx512(T* const p,
+                                                          size_t const n,
+                                                          T const pivot) {
+    constexpr size_t W = 64 / sizeof(T);
+    if (n < 2 * W) {
+      return scalar(p, n, pivot);
+    }
+    __m512i pv;
+    if constexpr (std::is_same_v<T, float>) {
+      pv = _mm512_castps_si512(_mm512_set1_ps(pivot));
+    } else if constexpr (std::is_same_v<T, double>) {
+      pv = _mm512_castpd_si512(_mm512_set1_pd(pivot));
+    } else if constexpr (sizeof(T) == 4) {
+      pv = _mm512_set1_epi32(static_cast<int32_t>(pivot));
+    } else {
+      pv = _mm512_set1_epi64(static_cast<int64_t>(pivot));
+    }
+    constexpr uint32_t EVEN = sizeof(T) == 4 ? 0x5555 : 0x55;
+
+    T rest[3 * W];
+    std::memcpy(rest, p, W * sizeof(T));
+    std::memcpy(rest + W, p + n - W, W * sizeof(T));
+    size_t lw = 0, rw = n, lr = W, rr = n - W;
+    while (rr - lr >= W) {
+      T const* src;
+      if (lr - lw <= rw - rr) {
+        src = p + lr;
+        lr += W;
+      } else {
+        rr -= W;
+        src = p + rr;
+      }
+      __m512i const v = _mm512_loadu_si512(src);
+      uint32_t lt, eq;
+      if constexpr (std::is_same_v<T, float>) {
+        __m512 const x = _mm512_castsi512_ps(v), y = _mm512_castsi512_ps(pv);
+        lt = _mm512_cmp_ps_mask(x, y, _CMP_LT_OQ);
+        eq = _mm512_cmp_ps_mask(x, y, _CMP_EQ_OQ);
+      } else if constexpr (std::is_same_v<T, double>) {
+        __m512d const x = _mm512_castsi512_pd(v), y = _mm512_castsi512_pd(pv);
+        lt = _mm512_cmp_pd_mask(x, y, _CMP_LT_OQ);
+        eq = _mm512_cmp_pd_mask(x, y, _CMP_EQ_OQ);
+      } else if constexpr (sizeof(T) == 4) {
+        lt = _mm512_cmplt_epi32_mask(v, pv);
+        eq = _mm512_cmpeq_epi32_mask(v, pv);
+      } else {
+        lt = _mm512_cmplt_epi64_mask(v, pv);
+        eq = _mm512_cmpeq_epi64_mask(v, pv);
+      }
+      uint32_t const m = lt | (eq & EVEN);
+      size_t const nl = static_cast<size_t>(std::popcount(m));
+      size_t const nr = W - nl;
+      // the right keys by a masked store, which writes no further
+      if constexpr (sizeof(T) == 4) {
+        __mmask16 const l = static_cast<__mmask16>(m);
+        _mm512_storeu_si512(p + lw, _mm512_maskz_compress_epi32(l, v));
+        _mm512_mask_storeu_epi32(
+            p + rw - nr, static_cast<__mmask16>((uint32_t(1) << nr) - 1),
+            _mm512_maskz_compress_epi32(static_cast<__mmask16>(~l), v));
+      } else {
+        __mmask8 const l = static_cast<__mmask8>(m);
+        _mm512_storeu_si512(p + lw, _mm512_maskz_compress_epi64(l, v));
+        _mm512_mask_storeu_epi64(
+            p + rw - nr, static_cast<__mmask8>((uint32_t(1) << nr) - 1),
+            _mm512_maskz_compress_epi64(static_cast<__mmask8>(~l), v));
+      }
+      lw += nl;
+      rw -= nr;
+    }
+    std::memcpy(rest + 2 * W, p + lr, (rr - lr) * sizeof(T));
+    return finish(p, lw, rw, rest, 2 * W + rr - lr, pivot);
+  }
+#else
+  static size_t avx2(T* const p, size_t const n, T const pivot) {
+    return scalar(p, n, pivot);
+  }
+
+  static size_t avx512(T* const p, size_t const n, T const pivot) {
+    return scalar(p, n, pivot);
+  }
+#endif
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_PARTITION_HPP__
@@ -1,21 +1,31 @@
 #ifndef __ALG_SORT_QUICK_HPP__
 #define __ALG_SORT_QUICK_HPP__
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <parallel/scheduler.hpp>
 #include <random/random.hpp>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <sort/common.hpp>
+#include <sort/heap.hpp>
 #include <sort/insertion.hpp>
+#include <sort/network.hpp>
+#include <sort/partition.hpp>
 
 namespace alg {
 /*
  * quick sort
  */
-template <typename T, bool (*cmp)(T const&, T const&) = Order<T>::less>
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
 class Quick {
   using Vector = std::vector<T>;
 
@@ -70,10 +80,14 @@ class Quick {
 
 /*
  * quick sort with practical improvements added
- * 1. insertion cutoff
+ * 1. insertion cutoff, or sorting network cutoff for arithmetic keys in
+ *    ascending order
  * 2. median of three select
+ * 3. `SimdPartition` partitions 32 and 64 bit keys in ascending order, a
+ *    vector at a time
  */
-template <typename T, bool (*cmp)(T const&, T const&) = Order<T>::less>
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
 class QuickX {
   using Vector = std::vector<T>;
 
@@ -85,15 +99,27 @@ class QuickX {
     }
   }
 
- private:
+ protected:
   static constexpr size_t INSERTION_CUTOFF = 8;
+  static constexpr bool NETWORK =
+      Network<T>::ENABLED && is_less_order<T, cmp>();
+  static constexpr size_t NETWORK_CUTOFF = 32;
+  static constexpr bool SIMD =
+      SimdPartition<T>::ENABLED && is_less_order<T, cmp>();
 
   static void sort(Vector& a, size_t const lo, size_t const hi) {
     if (hi <= lo) {
       return;
     }
-    // insertion sort for small subarrays
     size_t const n = 1 + hi - lo;
+    // sorting network for small subarrays of numbers
+    if constexpr (NETWORK) {
+      if (n <= NETWORK_CUTOFF) {
+        Network<T>::sort(a, lo, hi);
+        return;
+      }
+    }
+    // insertion sort for small subarrays
     if (n <= INSERTION_CUTOFF) {
       Insertion<T, cmp>::sort(a, lo, hi);
       return;
@@ -109,6 +135,9 @@ class QuickX {
     size_t const n = hi - lo + 1;
     size_t const m = median3(a, lo, lo + n / 2, hi);
     std::swap(a[lo], a[m]);
+    if constexpr (SIMD) {
+      return simd_partition(a, lo, hi);
+    }
     size_t i = lo, j = hi + 1;
     while (true) {
       while (cmp(a[++i], a[lo])) {
@@ -130,6 +159,14 @@ class QuickX {
     return j;
   }
 
+  // `a[lo + 1..hi]` by the vector kernel, around `a[lo]`
+  static size_t simd_partition(Vector& a, size_t const lo, size_t const hi) {
+    size_t const j =
+        lo + SimdPartition<T>::partition(a.data() + lo + 1, hi - lo, a[lo]);
+    std::swap(a[lo], a[j]);
+    return j;
+  }
+
   static size_t median3(Vector& a,
                         size_t const i,
                         size_t const j,
@@ -139,12 +176,382 @@ class QuickX {
   }
 };
 
+/*
+ * quick sort: task parallel version of `QuickX`
+ * the up-front shuffle is `Random::parallel_shuffle` on the same scheduler.
+ * after each partition the left part is forked as a stealable task and the
+ * right part is kept by the current task; subarrays no longer than
+ * `PARALLEL_CUTOFF` are sorted serially by `QuickX`
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class ParallelQuickX : QuickX<T, cmp> {
+  using Vector = std::vector<T>;
+  using Base = QuickX<T, cmp>;
+
+ public:
+  static void sort(Vector& a, Scheduler& sched = Scheduler::instance()) {
+    Random<T>::parallel_shuffle(a, sched);
+    if (!a.empty()) {
+      TaskGroup tg(sched);
+      sort(a, 0, a.size() - 1, tg);
+      tg.wait();
+    }
+  }
+
+ private:
+  static constexpr size_t PARALLEL_CUTOFF = 1 << 13;
+
+  static void sort(Vector& a, size_t lo, size_t const hi, TaskGroup& tg) {
+    while (hi > lo && hi - lo + 1 > PARALLEL_CUTOFF) {
+      size_t const j = Base::partition(a, lo, hi);
+      if (j > lo) {
+        tg.run([&a, lo, j, &tg] { sort(a, lo, j - 1, tg); });
+      }
+      lo = j + 1;
+    }
+    Base::sort(a, lo, hi);
+  }
+};
+
+/*
+ * quick sort: introspective, pattern-defeating (pdqsort)
+ * 1. no up-front shuffle: median of three, or Tukey's ninther for large
+ *    subarrays, picks the pivot
+ * 2. a highly unbalanced partition swaps a few elements around to break the
+ *    pattern; after log(n) of them `Heap` sorts the rest, which bounds the
+ *    worst case to O(n log n)
+ * 3. a pivot equal to the element left of the subarray means many
+ *    duplicates: elements equal to it are gathered in one go and skipped
+ * 4. a partition that swapped nothing hints a sorted subarray, which a
+ *    bounded insertion sort tries to finish
+ * 5. for arithmetic `T` the partition is branchless (BlockQuicksort):
+ *    comparisons only record offsets of misplaced elements in small buffers,
+ *    which are swapped afterwards, so mispredictions no longer depend on data
+ *
+ * subarrays are half-open `[lo, hi)` here.
+ * Ref: https://arxiv.org/abs/2106.05123, https://arxiv.org/abs/1604.06697
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class IntroQuickX {
+  using Vector = std::vector<T>;
+
+ public:
+  static void sort(Vector& a) {
+    size_t const n = a.size();
+    if (n > 1) {
+      sort(a, 0, n, static_cast<int>(std::bit_width(n)), true);
+    }
+  }
+
+  // sort `[lo, hi)` only
+  static void sort(Vector& a, size_t const lo, size_t const hi) {
+    if (hi - lo > 1) {
+      sort(a, lo, hi, static_cast<int>(std::bit_width(hi - lo)), true);
+    }
+  }
+
+ private:
+  static constexpr size_t INSERTION_CUTOFF = 24;
+  static constexpr size_t NINTHER_CUTOFF = 128;
+  static constexpr size_t PARTIAL_INSERTION_LIMIT = 8;
+  static constexpr size_t BLOCK_SIZE = 64;
+  static constexpr bool BRANCHLESS = std::is_arithmetic_v<T>;
+
+  // `leftmost` is false when `a[lo - 1]` is a pivot no greater than any
+  // element of `[lo, hi)`
+  static void sort(Vector& a,
+                   size_t lo,
+                   size_t const hi,
+                   int bad_allowed,
+                   bool leftmost) {
+    while (true) {
+      size_t const n = hi - lo;
+      if (n < INSERTION_CUTOFF) {
+        insertion(a, lo, hi, leftmost);
+        return;
+      }
+
+      // pivot to `a[lo]`
+      size_t const m = lo + n / 2;
+      if (n > NINTHER_CUTOFF) {
+        sort3(a, lo, m, hi - 1);
+        sort3(a, lo + 1, m - 1, hi - 2);
+        sort3(a, lo + 2, m + 1, hi - 3);
+        sort3(a, m - 1, m, m + 1);
+        std::swap(a[lo], a[m]);
+      } else {
+        sort3(a, m, lo, hi - 1);
+      }
+
+      // many duplicates of the previous pivot: put them on the left, where
+      // they are already in their final positions
+      if (!leftmost && !cmp(a[lo - 1], a[lo])) {
+        lo = partition_left(a, lo, hi) + 1;
+        continue;
+      }
+
+      auto const [p, partitioned] =
+          BRANCHLESS ? partition_right_branchless(a, lo, hi)
+                     : partition_right(a, lo, hi);
+      size_t const l_size = p - lo, r_size = hi - p - 1;
+      if (l_size < n / 8 || r_size < n / 8) {
+        // too many bad pivots, quadratic time ahead
+        if (--bad_allowed == 0) {
+          Heap<T, cmp>::sort(a, lo, hi - 1);
+          return;
+        }
+        break_pattern(a, lo, p, l_size);
+        break_pattern(a, p + 1, hi, r_size);
+      } else if (partitioned && partial_insertion(a, lo, p) &&
+                 partial_insertion(a, p + 1, hi)) {
+        return;
+      }
+      sort(a, lo, p, bad_allowed, leftmost);
+      lo = p + 1;
+      leftmost = false;
+    }
+  }
+
+  static void sort2(Vector& a, size_t const i, size_t const j) {
+    if (cmp(a[j], a[i])) {
+      std::swap(a[i], a[j]);
+    }
+  }
+
+  // median of the three to `a[j]`
+  static void sort3(Vector& a, size_t const i, size_t const j, size_t const k) {
+    sort2(a, i, j);
+    sort2(a, j, k);
+    sort2(a, i, j);
+  }
+
+  // swap a few elements to other places of `[lo, hi)`
+  static void break_pattern(Vector& a,
+                            size_t const lo,
+                            size_t const hi,
+                            size_t const n) {
+    if (n < INSERTION_CUTOFF) {
+      return;
+    }
+    std::swap(a[lo], a[lo + n / 4]);
+    std::swap(a[hi - 1], a[hi - n / 4]);
+    if (n > NINTHER_CUTOFF) {
+      std::swap(a[lo + 1], a[lo + n / 4 + 1]);
+      std::swap(a[lo + 2], a[lo + n / 4 + 2]);
+      std::swap(a[hi - 2], a[hi - n / 4 - 1]);
+      std::swap(a[hi - 3], a[hi - n / 4 - 2]);
+    }
+  }
+
+  // when not `leftmost`, `a[lo - 1]` stops the inner loop
+  static void insertion(Vector& a,
+                        size_t const lo,
+                        size_t const hi,
+                        bool const leftmost) {
+    for (size_t i = lo + 1; i < hi; i++) {
+      if (!cmp(a[i], a[i - 1])) {
+        continue;
+      }
+      T t = std::move(a[i]);
+      size_t j = i;
+      do {
+        a[j] = std::move(a[j - 1]);
+        j--;
+      } while ((!leftmost || j > lo) && cmp(t, a[j - 1]));
+      a[j] = std::move(t);
+    }
+  }
+
+  // insertion sort giving up after `PARTIAL_INSERTION_LIMIT` moves
+  static bool partial_insertion(Vector& a, size_t const lo, size_t const hi) {
+    size_t moves = 0;
+    for (size_t i = lo + 1; i < hi; i++) {
+      if (cmp(a[i], a[i - 1])) {
+        T t = std::move(a[i]);
+        size_t j = i;
+        do {
+          a[j] = std::move(a[j - 1]);
+          j--;
+        } while (j > lo && cmp(t, a[j - 1]));
+        a[j] = std::move(t);
+        moves += i - j;
+      }
+      if (moves > PARTIAL_INSERTION_LIMIT) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // partition `[lo, hi)` around `a[lo]` into `< pivot` and `>= pivot`.
+  // return the final position of the pivot, and whether nothing was swapped.
+  // the median-of-three leaves an element `>= pivot` at the right end.
+  static std::pair<size_t, bool> partition_right(Vector& a,
+                                                 size_t const lo,
+                                                 size_t const hi) {
+    T pivot = std::move(a[lo]);
+    size_t i = lo, j = hi;
+    while (cmp(a[++i], pivot)) {
+    }
+    if (i - 1 == lo) {
+      while (i < j && !cmp(a[--j], pivot)) {
+      }
+    } else {
+      while (!cmp(a[--j], pivot)) {
+      }
+    }
+    bool const partitioned = i >= j;
+    while (i < j) {
+      std::swap(a[i], a[j]);
+      while (cmp(a[++i], pivot)) {
+      }
+      while (!cmp(a[--j], pivot)) {
+      }
+    }
+    size_t const p = i - 1;
+    a[lo] = std::move(a[p]);
+    a[p] = std::move(pivot);
+    return {p, partitioned};
+  }
+
+  // same contract as `partition_right`
+  static std::pair<size_t, bool> partition_right_branchless(Vector& a,
+                                                            size_t const lo,
+                                                            size_t const hi) {
+    T pivot = std::move(a[lo]);
+    size_t i = lo, j = hi;
+    while (cmp(a[++i], pivot)) {
+    }
+    if (i - 1 == lo) {
+      while (i < j && !cmp(a[--j], pivot)) {
+      }
+    } else {
+      while (!cmp(a[--j], pivot)) {
+      }
+    }
+    bool const partitioned = i >= j;
+    if (!partitioned) {
+      std::swap(a[i], a[j]);
+      i++;
+      // `offsets_l` of elements `>= pivot` from `base_l` forward,
+      // `offsets_r` of elements `< pivot` from `base_r` backward
+      alignas(64) uint8_t offsets_l[BLOCK_SIZE];
+      alignas(64) uint8_t offsets_r[BLOCK_SIZE];
+      size_t base_l = i, base_r = j;
+      size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+      while (i < j) {
+        // refill an empty buffer with a block, or with what is left
+        size_t const unknown = j - i;
+        size_t const left_split =
+            num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+        size_t const right_split = num_r == 0 ? unknown - left_split : 0;
+        size_t const nl = std::min(left_split, BLOCK_SIZE);
+        size_t const nr = std::min(right_split, BLOCK_SIZE);
+        for (size_t k = 0; k < nl; k++) {
+          offsets_l[num_l] = static_cast<uint8_t>(k);
+          num_l += !cmp(a[i++], pivot);
+        }
+        for (size_t k = 0; k < nr;) {
+          offsets_r[num_r] = static_cast<uint8_t>(++k);
+          num_r += cmp(a[--j], pivot);
+        }
+        // swap misplaced pairs
+        size_t const num = std::min(num_l, num_r);
+        swap_offsets(a, base_l, base_r, offsets_l + start_l,
+                     offsets_r + start_r, num, num_l == num_r);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) {
+          start_l = 0;
+          base_l = i;
+        }
+        if (num_r == 0) {
+          start_r = 0;
+          base_r = j;
+        }
+      }
+      // leftover misplaced elements of one side go next to the middle
+      if (num_l > 0) {
+        while (num_l-- > 0) {
+          std::swap(a[base_l + offsets_l[start_l + num_l]], a[--j]);
+        }
+        i = j;
+      }
+      if (num_r > 0) {
+        while (num_r-- > 0) {
+          std::swap(a[base_r - offsets_r[start_r + num_r]], a[i++]);
+        }
+      }
+    }
+    size_t const p = i - 1;
+    a[lo] = std::move(a[p]);
+    a[p] = std::move(pivot);
+    return {p, partitioned};
+  }
+
+  // exchange `num` pairs, with a rotation through one temporary instead of
+  // swaps when the buffers may still refer to the same elements later
+  static void swap_offsets(Vector& a,
+                           size_t const base_l,
+                           size_t const base_r,
+                           uint8_t const* offsets_l,
+                           uint8_t const* offsets_r,
+                           size_t const num,
+                           bool const use_swaps) {
+    if (use_swaps) {
+      for (size_t k = 0; k < num; k++) {
+        std::swap(a[base_l + offsets_l[k]], a[base_r - offsets_r[k]]);
+      }
+    } else if (num > 0) {
+      size_t l = base_l + offsets_l[0], r = base_r - offsets_r[0];
+      T t = std::move(a[l]);
+      a[l] = std::move(a[r]);
+      for (size_t k = 1; k < num; k++) {
+        l = base_l + offsets_l[k];
+        a[r] = std::move(a[l]);
+        r = base_r - offsets_r[k];
+        a[l] = std::move(a[r]);
+      }
+      a[r] = std::move(t);
+    }
+  }
+
+  // partition `[lo, hi)` around `a[lo]` into `<= pivot` and `> pivot`,
+  // where nothing is less than the pivot. return the final pivot position.
+  static size_t partition_left(Vector& a, size_t const lo, size_t const hi) {
+    T pivot = std::move(a[lo]);
+    size_t i = lo, j = hi;
+    while (cmp(pivot, a[--j])) {
+    }
+    if (j + 1 == hi) {
+      while (i < j && !cmp(pivot, a[++i])) {
+      }
+    } else {
+      while (!cmp(pivot, a[++i])) {
+      }
+    }
+    while (i < j) {
+      std::swap(a[i], a[j]);
+      while (cmp(pivot, a[--j])) {
+      }
+      while (!cmp(pivot, a[++i])) {
+      }
+    }
+    a[lo] = std::move(a[j]);
+    a[j] = std::move(pivot);
+    return j;
+  }
+};
+
 /*
  * quick sort: three-way partition
  */
-template <typename T,
-          int (*cmp)(T const& t1, T const& t2) =
-              Order<T>::default_three_way_comparator>
+template <typename T, auto cmp = Order<T>::default_three_way_comparator>
+  requires ThreeWayComparator<decltype(cmp), T>
 class Quick3Way {
   using Vector = std::vector<T>;
 
@@ -161,10 +568,10 @@ class Quick3Way {
     if (hi <= lo) {
       return;
     }
+    // `a[lt]` always holds an item equal to the pivot
     size_t lt = lo, i = lo + 1, gt = hi;
-    T const v = a[lo];
     while (i <= gt) {
-      int const r = cmp(a[i], v);
+      int const r = cmp(a[i], a[lt]);
       if (r < 0) {
         std::swap(a[i], a[lt]);
         i++;
@@ -176,17 +583,19 @@ class Quick3Way {
         i++;
       }
     }
-    if (lt > 0) {
-      sort(a, lo, lt - 1, cmp);
+    if (lt > lo) {
+      sort(a, lo, lt - 1);
     }
-    sort(a, gt + 1, hi, cmp);
+    sort(a, gt + 1, hi);
   }
 };
 
-// three way partition
-template <typename T, bool (*cmp)(T const& t1, T const& t2) = Order<T>::less>
-class QuickSelect {
+// three way partition, by `SimdPartition` where `QuickX` uses it
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class QuickSelect : QuickX<T, cmp> {
   using Vector = std::vector<T>;
+  using Base = QuickX<T, cmp>;
 
  public:
   static T const& select(Vector& a, size_t k) {
@@ -211,6 +620,9 @@ class QuickSelect {
 
  private:
   static size_t partition(Vector& a, size_t const lo, size_t const hi) {
+    if constexpr (Base::SIMD) {
+      return Base::simd_partition(a, lo, hi);
+    }
     size_t i = lo, j = hi + 1;
     while (true) {
       while (cmp(a[++i], a[lo])) {
@@ -233,6 +645,185 @@ class QuickSelect {
   }
 };
 
+/*
+ * multi-rank selection
+ * puts the item of every requested rank at its sorted position in a single
+ * recursive partitioning pass: only parts still holding a requested rank are
+ * partitioned further, so p50, p90 and p99 together cost little more than
+ * the deepest of them alone, and far less than a sort.
+ *
+ * three-way partitioning around a median of three settles runs of equal keys
+ * at once. the input is not shuffled: past a depth limit of `2 * log2(n)` the
+ * remaining part is heap sorted, which bounds the worst case.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class MultiSelect : QuickX<T, cmp> {
+  using Vector = std::vector<T>;
+  using Base = QuickX<T, cmp>;
+
+ public:
+  // items of rank `ranks[i]`, in the order of `ranks`
+  static Vector select(Vector& a, std::vector<size_t> const& ranks) {
+    std::vector<size_t> sorted(ranks);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    if (!sorted.empty() && sorted.back() >= a.size()) {
+      throw std::runtime_error(
+          "MultiSelect selecting error: cannot select out-of-range element");
+    }
+    if (!sorted.empty()) {
+      select(a, 0, a.size() - 1, sorted.data(), sorted.data() + sorted.size(),
+             2 * static_cast<int>(std::bit_width(a.size())));
+    }
+    Vector r;
+    r.reserve(ranks.size());
+    for (size_t const k : ranks) {
+      r.push_back(a[k]);
+    }
+    return r;
+  }
+
+  // nearest-rank quantiles, `qs[i]` in `[0, 1]`
+  static Vector quantiles(Vector& a, std::vector<double> const& qs) {
+    if (a.empty()) {
+      throw std::runtime_error(
+          "MultiSelect quantile error: no quantile of an empty array");
+    }
+    size_t const n = a.size();
+    std::vector<size_t> ranks;
+    ranks.reserve(qs.size());
+    for (double const q : qs) {
+      if (!(q >= 0 && q <= 1)) {
+        throw std::runtime_error(
+            "MultiSelect quantile error: quantile out of [0, 1]");
+      }
+      size_t const r = static_cast<size_t>(std::ceil(q * n));
+      ranks.push_back(r == 0 ? 0 : std::min(r, n) - 1);
+    }
+    return select(a, ranks);
+  }
+
+ private:
+  // ranks `[rb, re)`, sorted, all in `[lo, hi]`
+  static void select(Vector& a,
+                     size_t lo,
+                     size_t const hi,
+                     size_t const* rb,
+                     size_t const* const re,
+                     int depth) {
+    while (rb != re) {
+      if (hi - lo < Base::INSERTION_CUTOFF) {
+        Insertion<T, cmp>::sort(a, lo, hi);
+        return;
+      }
+      if (depth-- == 0) {
+        Heap<T, cmp>::sort(a, lo, hi);
+        return;
+      }
+      std::swap(a[lo], a[Base::median3(a, lo, lo + (hi - lo) / 2, hi)]);
+      // a[lo..lt-1] < a[lt..gt] < a[gt+1..hi], `a[lt]` the pivot
+      size_t lt = lo, i = lo + 1, gt = hi;
+      while (i <= gt) {
+        if (cmp(a[i], a[lt])) {
+          std::swap(a[lt++], a[i++]);
+        } else if (cmp(a[lt], a[i])) {
+          std::swap(a[i], a[gt--]);
+        } else {
+          i++;
+        }
+      }
+      size_t const* const left = std::lower_bound(rb, re, lt);
+      size_t const* const right = std::upper_bound(left, re, gt);
+      if (rb != left) {
+        select(a, lo, lt - 1, rb, left, depth);
+      }
+      rb = right;
+      lo = gt + 1;
+    }
+  }
+};
+
+/*
+ * incremental quick sort (Paredes and Navarro)
+ * yields the items in order one at a time, sorting only as far as they are
+ * read: `O(n + k log k)` expected for the first `k` items, so a page of
+ * results costs about one partition of what is left plus its own sort.
+ *
+ * a stack keeps the pivots of past partitions, innermost on top, each in
+ * its final place, and everything before a pivot no greater than it. `next`
+ * partitions the part between the next position and the top pivot with
+ * `QuickX::partition` until the next position is a pivot itself, then pops
+ * it. parts of at most `INSERTION_CUTOFF` items are insertion sorted at once.
+ * the items are shuffled up front, as by `QuickX::sort`.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class IncrementalQuick : QuickX<T, cmp> {
+  using Vector = std::vector<T>;
+  using Base = QuickX<T, cmp>;
+
+  Vector a_;
+  // pivots, the innermost on top; `a_.size()` at the bottom as a sentinel
+  std::vector<size_t> pivots_;
+  // position of the next item, and end of the prefix known to be sorted
+  size_t next_ = 0;
+  size_t sorted_ = 0;
+
+ public:
+  explicit IncrementalQuick(Vector a) : a_(std::move(a)) {
+    Random<T>::shuffle(a_);
+    pivots_.push_back(a_.size());
+  }
+
+  size_t size() const { return a_.size(); }
+
+  // items yielded so far
+  size_t position() const { return next_; }
+
+  bool has_next() const { return next_ < a_.size(); }
+
+  // the least item not yet yielded
+  T const& next() {
+    if (!has_next()) {
+      throw std::runtime_error("IncrementalQuick error: no item left");
+    }
+    if (next_ >= sorted_) {
+      settle();
+    }
+    return a_[next_++];
+  }
+
+  // the next `k` items, fewer at the end
+  Vector take(size_t const k) {
+    Vector r;
+    r.reserve(std::min(k, a_.size() - next_));
+    while (r.size() < k && has_next()) {
+      r.push_back(next());
+    }
+    return r;
+  }
+
+ private:
+  // sort up to at least `a_[next_]`
+  void settle() {
+    while (true) {
+      size_t const top = pivots_.back();
+      if (top == next_) {
+        pivots_.pop_back();
+        sorted_ = next_ + 1;
+        return;
+      }
+      if (top - next_ <= Base::INSERTION_CUTOFF) {
+        Insertion<T, cmp>::sort(a_, next_, top - 1);
+        sorted_ = top;
+        return;
+      }
+      pivots_.push_back(Base::partition(a_, next_, top - 1));
+    }
+  }
+};
+
 };  // namespace alg
 
 #endif  // !__ALG_SORT_QUICK_HPP__
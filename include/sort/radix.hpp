@@ -0,0 +1,135 @@
+#ifndef __ALG_SORT_RADIX_HPP__
+#define __ALG_SORT_RADIX_HPP__
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace alg {
+/*
+ * fixed-width keys that radix sorts accept: integers (but `bool`) and
+ * floating points of 1, 2, 4 or 8 bytes
+ */
+template <typename T>
+concept RadixKey = (std::integral<T> && !std::same_as<T, bool>) ||
+                   (std::floating_point<T> &&
+                    (sizeof(T) == 4 || sizeof(T) == 8));
+
+/*
+ * order-preserving transform of a key into an unsigned integer, so that
+ * comparing the transformed bits as unsigned gives the order of the keys:
+ * 1. unsigned: kept as is
+ * 2. signed: sign bit flipped
+ * 3. floating point: all bits of negatives flipped, sign bit of the others
+ *    (-0.0 sorts before +0.0, NaNs go to both ends by their sign bit)
+ */
+template <RadixKey T>
+class RadixBits {
+ public:
+  using Bits = std::conditional_t<
+      sizeof(T) <= 2,
+      std::conditional_t<sizeof(T) == 1, uint8_t, uint16_t>,
+      std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+
+  static constexpr size_t WIDTH = 8 * sizeof(T);
+  static constexpr Bits SIGN = Bits(1) << (WIDTH - 1);
+
+  static Bits encode(T const t) {
+    Bits const b = std::bit_cast<Bits>(t);
+    if constexpr (std::floating_point<T>) {
+      // all ones for negatives, only the sign bit otherwise
+      Bits const mask = Bits(-Bits(b >> (WIDTH - 1))) | SIGN;
+      return b ^ mask;
+    } else if constexpr (std::is_signed_v<T>) {
+      return b ^ SIGN;
+    } else {
+      return b;
+    }
+  }
+
+  // `encode` with -0.0 taken as +0.0, so that keys equal by `==` get the
+  // same bits (NaNs aside): for orders that must tell equal keys apart only
+  // by position, i.e. stable sorts
+  static Bits encode_value(T const t) {
+    if constexpr (std::floating_point<T>) {
+      return encode(t == T(0) ? T(0) : t);
+    } else {
+      return encode(t);
+    }
+  }
+
+  // `b`-th byte of the transformed key, the least significant one first
+  static uint8_t digit(T const t, size_t const b) {
+    return static_cast<uint8_t>(encode(t) >> (8 * b));
+  }
+};
+
+/*
+ * LSD radix sort
+ * stable, one counting pass per byte from the least significant one.
+ * counts of all bytes are gathered in a single sweep before any pass, and a
+ * pass is skipped when every key has the same byte there (e.g. high bytes of
+ * small ids or timestamps).
+ */
+template <RadixKey T>
+class LSD {
+  using Vector = std::vector<T>;
+  using Bits = RadixBits<T>;
+
+  static constexpr size_t R = 256;
+  static constexpr size_t W = sizeof(T);
+
+ public:
+  static void sort(Vector& a) {
+    size_t const n = a.size();
+    if (n < 2) {
+      return;
+    }
+    // histograms of every byte in one pass
+    std::vector<std::array<size_t, R>> count(W);
+    for (auto& c : count) {
+      c.fill(0);
+    }
+    for (size_t i = 0; i < n; i++) {
+      auto const key = Bits::encode(a[i]);
+      for (size_t b = 0; b < W; b++) {
+        count[b][static_cast<uint8_t>(key >> (8 * b))]++;
+      }
+    }
+
+    Vector aux(n);
+    Vector* from = &a;
+    Vector* to = &aux;
+    for (size_t b = 0; b < W; b++) {
+      auto& c = count[b];
+      // constant digit, nothing would move
+      if (c[Bits::digit(a[0], b)] == n) {
+        continue;
+      }
+      // counts to start indices
+      size_t start = 0;
+      for (size_t r = 0; r < R; r++) {
+        size_t const cnt = c[r];
+        c[r] = start;
+        start += cnt;
+      }
+      // distribute
+      Vector& src = *from;
+      Vector& dst = *to;
+      for (size_t i = 0; i < n; i++) {
+        dst[c[Bits::digit(src[i], b)]++] = src[i];
+      }
+      std::swap(from, to);
+    }
+    if (from != &a) {
+      a.swap(aux);
+    }
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_RADIX_HPP__
@@ -0,0 +1,453 @@
+#ifndef __ALG_SORT_SAMPLE_HPP__
+#define __ALG_SORT_SAMPLE_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <sort/common.hpp>
+#include <sort/quick.hpp>
+
+namespace alg {
+/*
+ * in-place parallel samplesort (IPS4o, Axtmann, Witt, Ferizovic and Sanders)
+ * each step splits a range into up to 256 buckets by `k - 1` splitters
+ * drawn from a sample, then sorts the buckets recursively, as parallel
+ * tasks:
+ * 1. classification: the range is cut into one stripe per thread. a stripe
+ *    is read in order, each item finding its bucket by a branchless descent
+ *    of the splitters laid out as an implicit search tree, and goes to a
+ *    small buffer of its bucket. a full buffer is written back as a block to
+ *    the front of the stripe, over items already read.
+ * 2. block permutation: bucket boundaries, rounded to whole blocks, come
+ *    from the counts. the blocks are swapped to their buckets in place,
+ *    each thread taking a block from the back of the unread blocks of a
+ *    bucket and chaining swaps until it drops a block into an empty slot.
+ *    threads meet only on a lock per bucket.
+ * 3. cleanup: the buffers, and the parts of blocks crossing a bucket
+ *    boundary, fill the rest of each bucket.
+ * only `O(k * b)` items of extra memory per thread, `b` the items of a 2 KiB
+ * block, whatever `n`: no `aux` array as in `Merge`, and unlike a parallel
+ * quick sort, the first step is parallel as well.
+ *
+ * a sample with repeated splitters means heavy keys: each repeated splitter
+ * then gets a bucket of the items equal to it, which need no more sorting.
+ * ranges up to `BASE_CASE` items, and any a step fails to split, are left
+ * to `IntroQuickX`.
+ *
+ * not stable.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class SampleSort {
+  using Vector = std::vector<T>;
+
+  // items per block
+  static constexpr size_t B = sizeof(T) < 2048 ? 2048 / sizeof(T) : 1;
+  static constexpr size_t MAX_LOG_BUCKETS = 8;
+  static constexpr size_t BASE_CASE = 16 * B > 4096 ? 16 * B : 4096;
+  // least items per stripe of a parallel step
+  static constexpr size_t STRIPE_MIN = 1 << 16;
+  // items classified at once, their descents interleaved
+  static constexpr size_t UNROLL = 4;
+
+  // splitters, and the bucket of an item
+  struct Classifier {
+    // the implicit search tree, root at 1
+    Vector tree;
+    Vector splitters;
+    size_t log_k = 0;
+    size_t k = 0;
+    bool equal = false;
+
+    size_t buckets() const { return equal ? 2 * k : k; }
+
+    // `b` such that `splitters[b - 1] < x <= splitters[b]`, and `2b` or
+    // `2b + 1` for equal to `splitters[b]` with equality buckets
+    template <size_t N>
+    void classify(T const* const x, size_t* const b) const {
+      size_t i[N];
+      for (size_t u = 0; u < N; u++) {
+        i[u] = 1;
+      }
+      for (size_t l = 0; l < log_k; l++) {
+        for (size_t u = 0; u < N; u++) {
+          i[u] = 2 * i[u] + static_cast<size_t>(cmp(tree[i[u]], x[u]));
+        }
+      }
+      for (size_t u = 0; u < N; u++) {
+        b[u] = i[u] - k;
+        if (equal) {
+          b[u] = 2 * b[u] +
+                 static_cast<size_t>(b[u] < k - 1 && !cmp(x[u], splitters[b[u]]));
+        }
+      }
+    }
+
+    size_t bucket(T const& x) const {
+      size_t b;
+      classify<1>(&x, &b);
+      return b;
+    }
+  };
+
+  // state of a thread in a step
+  struct Stripe {
+    size_t begin, end;
+    // end of the full blocks written back
+    size_t write;
+    // a buffer of `B` items per bucket, and the items in each
+    Vector buffer;
+    std::vector<size_t> fill;
+    // items of each bucket, buffered or in blocks
+    std::vector<size_t> count;
+  };
+
+  // blocks of a bucket in the permutation: `[w, r)` not yet read
+  struct alignas(64) Pointers {
+    std::mutex mu;
+    size_t w = 0, r = 0;
+    // blocks being read out of the bucket
+    std::atomic<size_t> reading{0};
+  };
+
+ public:
+  static void sort(Vector& a, Scheduler& sched = Scheduler::instance()) {
+    if (a.size() > 1) {
+      sort(a, 0, a.size(), sched);
+    }
+  }
+
+ private:
+  // sort `[lo, hi)`
+  static void sort(Vector& a,
+                   size_t const lo,
+                   size_t const hi,
+                   Scheduler& sched) {
+    size_t const n = hi - lo;
+    if (n <= BASE_CASE) {
+      IntroQuickX<T, cmp>::sort(a, lo, hi);
+      return;
+    }
+    Classifier c;
+    sample(a, lo, hi, c);
+    size_t const stripes =
+        std::max<size_t>(1, std::min(sched.concurrency(), n / STRIPE_MIN));
+    std::vector<size_t> const bounds = step(a, lo, hi, c, stripes, sched);
+
+    TaskGroup tg(sched);
+    for (size_t b = 0; b < c.buckets(); b++) {
+      // items equal to a splitter are done
+      if (c.equal && b % 2 == 1) {
+        continue;
+      }
+      size_t const bl = bounds[b], bh = bounds[b + 1];
+      if (bh - bl < 2) {
+        continue;
+      }
+      if (bh - bl == n || bh - bl <= BASE_CASE) {
+        IntroQuickX<T, cmp>::sort(a, bl, bh);
+      } else {
+        tg.run([&a, bl, bh, &sched] { sort(a, bl, bh, sched); });
+      }
+    }
+    tg.wait();
+  }
+
+  // splitters from a random sample of `[lo, hi)`
+  static void sample(Vector const& a,
+                     size_t const lo,
+                     size_t const hi,
+                     Classifier& c) {
+    size_t const n = hi - lo;
+    size_t log_k = std::bit_width(n / (BASE_CASE / 4)) - 1;
+    log_k = std::clamp<size_t>(log_k, 2, MAX_LOG_BUCKETS);
+    size_t const k = size_t(1) << log_k;
+    size_t const oversampling =
+        std::max<size_t>(1, std::bit_width(n) / 5);
+    Vector s;
+    s.reserve(oversampling * k);
+    DefaultRng& g = thread_rng();
+    for (size_t i = 0; i < oversampling * k; i++) {
+      s.push_back(a[lo + bounded(g, n)]);
+    }
+    IntroQuickX<T, cmp>::sort(s);
+
+    // `k - 1` evenly spaced, then repeats dropped
+    for (size_t j = 1; j < k; j++) {
+      c.splitters.push_back(s[j * oversampling - 1]);
+    }
+    size_t const drawn = c.splitters.size();
+    c.splitters.erase(std::unique(c.splitters.begin(), c.splitters.end(),
+                                  [](T const& x, T const& y) {
+                                    return !cmp(x, y);
+                                  }),
+                      c.splitters.end());
+    c.equal = c.splitters.size() < drawn;
+    // fewer buckets for fewer splitters, the tree padded with the last one
+    c.log_k = std::max<size_t>(1, std::bit_width(c.splitters.size()));
+    c.k = size_t(1) << c.log_k;
+    while (c.splitters.size() < c.k - 1) {
+      c.splitters.push_back(c.splitters.back());
+    }
+    c.tree.resize(c.k);
+    build_tree(c, 1, 0, c.k - 1);
+  }
+
+  // node `i` of the tree over `splitters[l, r)`
+  static void build_tree(Classifier& c,
+                         size_t const i,
+                         size_t const l,
+                         size_t const r) {
+    if (l >= r) {
+      return;
+    }
+    size_t const m = l + (r - l) / 2;
+    c.tree[i] = c.splitters[m];
+    build_tree(c, 2 * i, l, m);
+    build_tree(c, 2 * i + 1, m + 1, r);
+  }
+
+  // split `[lo, hi)` into the buckets of `c`, returning their boundaries
+  static std::vector<size_t> step(Vector& a,
+                                  size_t const lo,
+                                  size_t const hi,
+                                  Classifier const& c,
+                                  size_t const n_stripes,
+                                  Scheduler& sched) {
+    size_t const n = hi - lo;
+    size_t const nb = c.buckets();
+    // stripes start on whole blocks, and `n_stripes` of them cover `n`, so
+    // that every slot falls in the stripe `(slot - lo) / stripe_len`
+    size_t const stripe_len = ((n + n_stripes - 1) / n_stripes + B - 1) / B * B;
+    std::vector<Stripe> stripes(n_stripes);
+    for (size_t t = 0; t < n_stripes; t++) {
+      Stripe& s = stripes[t];
+      s.begin = std::min(hi, lo + t * stripe_len);
+      s.end = t + 1 == n_stripes ? hi : std::min(hi, s.begin + stripe_len);
+    }
+    for_each(n_stripes, sched, [&](size_t const t) {
+      classify(a, c, stripes[t]);
+    });
+
+    // bucket boundaries, and the same rounded up to whole blocks
+    std::vector<size_t> bounds(nb + 1), aligned(nb + 1), blocks(nb, 0);
+    size_t sum = lo;
+    for (size_t b = 0; b < nb; b++) {
+      bounds[b] = sum;
+      for (Stripe const& s : stripes) {
+        sum += s.count[b];
+        blocks[b] += (s.count[b] - s.fill[b]) / B;
+      }
+    }
+    bounds[nb] = hi;
+    for (size_t b = 0; b <= nb; b++) {
+      aligned[b] = lo + (bounds[b] - lo + B - 1) / B * B;
+    }
+    // the last slot on the block grid, past `hi` if `n` is not a multiple
+    size_t const grid_end = lo + n / B * B;
+
+    // full blocks to the front of the area of each bucket
+    std::unique_ptr<Pointers[]> ptrs(new Pointers[nb]);
+    auto const full = [&](size_t const slot) {
+      Stripe const& s = stripes[(slot - lo) / stripe_len];
+      return slot < s.write;
+    };
+    for_each(nb, sched, [&](size_t const b) {
+      size_t l = aligned[b], r = std::min(aligned[b + 1], grid_end);
+      while (true) {
+        while (l < r && full(l)) {
+          l += B;
+        }
+        while (l < r && !full(r - B)) {
+          r -= B;
+        }
+        if (l >= r) {
+          break;
+        }
+        r -= B;
+        std::move(a.begin() + r, a.begin() + r + B, a.begin() + l);
+        l += B;
+      }
+      ptrs[b].w = aligned[b];
+      ptrs[b].r = l;
+    });
+
+    Vector overflow(hi > grid_end ? B : 0);
+    std::atomic<size_t> overflow_bucket{nb};
+    for_each(n_stripes, sched, [&](size_t const t) {
+      permute(a, c, hi, ptrs.get(), t * nb / n_stripes, overflow,
+              overflow_bucket);
+    });
+
+    // blocks crossing into the next bucket are set aside first: the next
+    // bucket fills its own head over them
+    std::vector<size_t> spill_at(nb + 1, 0);
+    Vector spill;
+    for (size_t b = 0; b < nb; b++) {
+      spill_at[b] = spill.size();
+      if (blocks[b] == 0) {
+        continue;
+      }
+      size_t const w = end_of_blocks(aligned[b], blocks[b], b,
+                                     overflow_bucket.load());
+      for (size_t i = bounds[b + 1]; i < w; i++) {
+        spill.push_back(std::move(a[i]));
+      }
+    }
+    spill_at[nb] = spill.size();
+    for_each(nb, sched, [&](size_t const b) {
+      size_t const s = bounds[b], e = bounds[b + 1];
+      size_t const d = std::min(aligned[b], e);
+      size_t const w =
+          end_of_blocks(aligned[b], blocks[b], b, overflow_bucket.load());
+      // free slots: the head `[s, d)`, then the tail `[w, e)`
+      size_t i = s;
+      auto const put = [&](T& x) {
+        if (i == d) {
+          i = std::max(w, d);
+        }
+        a[i++] = std::move(x);
+      };
+      for (size_t j = spill_at[b]; j < spill_at[b + 1]; j++) {
+        put(spill[j]);
+      }
+      if (overflow_bucket.load() == b) {
+        for (T& x : overflow) {
+          put(x);
+        }
+      }
+      for (Stripe& st : stripes) {
+        for (size_t j = 0; j < st.fill[b]; j++) {
+          put(st.buffer[b * B + j]);
+        }
+      }
+    });
+    return bounds;
+  }
+
+  // end of the blocks of bucket `b` in place, the overflow block aside
+  static size_t end_of_blocks(size_t const aligned,
+                              size_t const blocks,
+                              size_t const b,
+                              size_t const overflow_bucket) {
+    return aligned + (blocks - (overflow_bucket == b)) * B;
+  }
+
+  static void classify(Vector& a, Classifier const& c, Stripe& s) {
+    size_t const nb = c.buckets();
+    s.buffer.resize(nb * B);
+    s.fill.assign(nb, 0);
+    s.count.assign(nb, 0);
+    s.write = s.begin;
+    auto const put = [&](size_t const b, T& x) {
+      s.buffer[b * B + s.fill[b]++] = std::move(x);
+      if (s.fill[b] == B) {
+        // at least `B` more items read than written back
+        std::move(s.buffer.begin() + b * B, s.buffer.begin() + (b + 1) * B,
+                  a.begin() + s.write);
+        s.write += B;
+        s.count[b] += B;
+        s.fill[b] = 0;
+      }
+    };
+    size_t i = s.begin;
+    size_t bucket[UNROLL];
+    for (; i + UNROLL <= s.end; i += UNROLL) {
+      c.template classify<UNROLL>(&a[i], bucket);
+      for (size_t u = 0; u < UNROLL; u++) {
+        put(bucket[u], a[i + u]);
+      }
+    }
+    for (; i < s.end; i++) {
+      put(c.bucket(a[i]), a[i]);
+    }
+    for (size_t b = 0; b < nb; b++) {
+      s.count[b] += s.fill[b];
+    }
+  }
+
+  // swap blocks to their buckets, reading from bucket `first` on
+  static void permute(Vector& a,
+                      Classifier const& c,
+                      size_t const hi,
+                      Pointers* const ptrs,
+                      size_t const first,
+                      Vector& overflow,
+                      std::atomic<size_t>& overflow_bucket) {
+    size_t const nb = c.buckets();
+    Vector hand(B), swap(B);
+    for (size_t k = 0; k < nb; k++) {
+      Pointers& p = ptrs[(first + k) % nb];
+      while (true) {
+        size_t from;
+        {
+          std::lock_guard<std::mutex> lk(p.mu);
+          if (p.r <= p.w) {
+            break;
+          }
+          p.r -= B;
+          from = p.r;
+          p.reading++;
+        }
+        std::move(a.begin() + from, a.begin() + from + B, hand.begin());
+        p.reading--;
+        // carry `hand` on until it lands in an empty slot
+        while (true) {
+          size_t const b = c.bucket(hand[0]);
+          Pointers& q = ptrs[b];
+          size_t slot;
+          bool occupied;
+          {
+            std::lock_guard<std::mutex> lk(q.mu);
+            slot = q.w;
+            q.w += B;
+            occupied = slot < q.r;
+          }
+          if (occupied) {
+            std::move(a.begin() + slot, a.begin() + slot + B, swap.begin());
+            std::move(hand.begin(), hand.end(), a.begin() + slot);
+            hand.swap(swap);
+            continue;
+          }
+          // the slot may still be read out by another thread
+          while (q.reading.load() > 0) {
+            std::this_thread::yield();
+          }
+          if (slot + B > hi) {
+            std::move(hand.begin(), hand.end(), overflow.begin());
+            overflow_bucket.store(b);
+          } else {
+            std::move(hand.begin(), hand.end(), a.begin() + slot);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  template <typename F>
+  static void for_each(size_t const n, Scheduler& sched, F const& f) {
+    if (n == 1) {
+      f(0);
+      return;
+    }
+    TaskGroup tg(sched);
+    for (size_t i = 0; i < n; i++) {
+      tg.run([&f, i] { f(i); });
+    }
+    tg.wait();
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_SAMPLE_HPP__
@@ -5,7 +5,8 @@
 #include <vector>
 
 namespace alg {
-template <typename T, bool (*cmp)(T const& t1, T const& t2) = Order<T>::less>
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
 class Selection {
   using Vector = std::vector<T>;
 
@@ -0,0 +1,207 @@
+#ifndef __ALG_SORT_SORT_HPP__
+#define __ALG_SORT_SORT_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <random/prng.hpp>
+#include <sort/common.hpp>
+#include <sort/insertion.hpp>
+#include <sort/merge.hpp>
+#include <sort/quick.hpp>
+#include <sort/radix.hpp>
+#include <sort/string_sort.hpp>
+
+namespace alg {
+enum class SortAlgorithm {
+  None,
+  Insertion,
+  NaturalMerge,
+  Radix,
+  IntroSort,
+};
+
+inline char const* to_string(SortAlgorithm const s) {
+  switch (s) {
+    case SortAlgorithm::None:
+      return "none";
+    case SortAlgorithm::Insertion:
+      return "insertion";
+    case SortAlgorithm::NaturalMerge:
+      return "natural_merge";
+    case SortAlgorithm::Radix:
+      return "radix";
+    case SortAlgorithm::IntroSort:
+      return "introsort";
+  }
+  return "unknown";
+}
+
+// what `sort` saw of its input, and what it chose
+struct SortStats {
+  size_t n = 0;
+  // adjacent pairs looked at, and the fractions of them in order and
+  // strictly reversed
+  size_t pairs = 0;
+  double ascending = 0;
+  double descending = 0;
+  // items sampled for duplicates, and the fraction of them equal to an
+  // earlier one of the sample
+  size_t sampled = 0;
+  double duplicates = 0;
+  SortAlgorithm algorithm = SortAlgorithm::None;
+};
+
+/*
+ * sort dispatching on the input
+ * about 3000 compares of samples decide, whatever `n`, in this order:
+ * 1. `n <= 32`: `Insertion`
+ * 2. adjacent pairs from evenly spaced windows, 90% or more in order, or
+ *    strictly reversed: `NaturalMerge`, close to linear on runs
+ * 3. integer or floating point keys in ascending order: `LSD` radix sort,
+ *    and `MSD` for strings
+ * 4. otherwise `IntroQuickX`, `O(n log n)` in the worst case
+ * `stats`, if any, receives the measures and the decision.
+ *
+ * the share of duplicates in a random sample is measured and reported, but
+ * few distinct keys still go to `IntroQuickX`: its partition gathers the
+ * keys equal to a repeated pivot in one go, a three-way partition, and ran
+ * faster than `Quick3Way` at every number of distinct keys tried, from 2 to
+ * 1024 among `2^20` records.
+ *
+ * not stable: use `NaturalMerge` or `Merge` directly when ties must keep
+ * their order.
+ */
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+class AdaptiveSort {
+  using Vector = std::vector<T>;
+
+  static constexpr size_t SMALL = 32;
+  // windows of adjacent pairs for presortedness
+  static constexpr size_t WINDOWS = 64;
+  static constexpr size_t WINDOW = 16;
+  static constexpr double PRESORTED = 0.9;
+  static constexpr size_t DUPLICATE_SAMPLE = 256;
+
+ public:
+  static void sort(Vector& a, SortStats* const stats = nullptr) {
+    SortStats s;
+    s.n = a.size();
+    s.algorithm = choose(a, s);
+    switch (s.algorithm) {
+      case SortAlgorithm::None:
+        break;
+      case SortAlgorithm::Insertion:
+        Insertion<T, cmp>::sort(a);
+        break;
+      case SortAlgorithm::NaturalMerge:
+        NaturalMerge<T, cmp>::sort(a);
+        break;
+      case SortAlgorithm::Radix:
+        radix(a);
+        break;
+      case SortAlgorithm::IntroSort:
+        IntroQuickX<T, cmp>::sort(a);
+        break;
+    }
+    if (stats != nullptr) {
+      *stats = s;
+    }
+  }
+
+ private:
+  static constexpr bool RADIX =
+      (RadixKey<T> || std::is_same_v<T, std::string>) &&
+      is_less_order<T, cmp>();
+
+  static SortAlgorithm choose(Vector const& a, SortStats& s) {
+    size_t const n = a.size();
+    if (n < 2) {
+      return SortAlgorithm::None;
+    }
+    if (n <= SMALL) {
+      return SortAlgorithm::Insertion;
+    }
+    presortedness(a, s);
+    if (s.ascending >= PRESORTED || s.descending >= PRESORTED) {
+      return SortAlgorithm::NaturalMerge;
+    }
+    duplicates(a, s);
+    if constexpr (RADIX) {
+      return SortAlgorithm::Radix;
+    }
+    return SortAlgorithm::IntroSort;
+  }
+
+  // pairs in up to `WINDOWS` windows of `WINDOW` items, spread evenly
+  // over `a`, `n > SMALL`
+  static void presortedness(Vector const& a, SortStats& s) {
+    size_t const n = a.size();
+    size_t const windows = std::min(WINDOWS, (n - 1) / WINDOW);
+    size_t asc = 0, desc = 0;
+    for (size_t w = 0; w < windows; w++) {
+      size_t const lo = w * (n - WINDOW) / (windows - 1);
+      for (size_t i = lo; i + 1 < lo + WINDOW; i++) {
+        if (cmp(a[i + 1], a[i])) {
+          desc++;
+        } else {
+          asc++;
+        }
+      }
+    }
+    s.pairs = asc + desc;
+    s.ascending = static_cast<double>(asc) / static_cast<double>(s.pairs);
+    s.descending = static_cast<double>(desc) / static_cast<double>(s.pairs);
+  }
+
+  // distinct positions drawn at random, sorted by their items
+  static void duplicates(Vector const& a, SortStats& s) {
+    size_t const n = a.size();
+    std::vector<size_t> idx;
+    if (n <= DUPLICATE_SAMPLE) {
+      idx.resize(n);
+      for (size_t i = 0; i < n; i++) {
+        idx[i] = i;
+      }
+    } else {
+      DefaultRng& g = thread_rng();
+      idx.resize(DUPLICATE_SAMPLE);
+      for (size_t& i : idx) {
+        i = bounded(g, n);
+      }
+      std::sort(idx.begin(), idx.end());
+      idx.erase(std::unique(idx.begin(), idx.end()), idx.end());
+    }
+    std::sort(idx.begin(), idx.end(), [&a](size_t const i, size_t const j) {
+      return cmp(a[i], a[j]);
+    });
+    size_t dup = 0;
+    for (size_t k = 1; k < idx.size(); k++) {
+      dup += !cmp(a[idx[k - 1]], a[idx[k]]);
+    }
+    s.sampled = idx.size();
+    s.duplicates = static_cast<double>(dup) / static_cast<double>(s.sampled);
+  }
+
+  static void radix(Vector& a) {
+    if constexpr (RadixKey<T>) {
+      LSD<T>::sort(a);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      MSD::sort(a);
+    }
+  }
+};
+
+template <typename T, auto cmp = Order<T>::less>
+  requires Comparator<decltype(cmp), T>
+void sort(std::vector<T>& a, SortStats* const stats = nullptr) {
+  AdaptiveSort<T, cmp>::sort(a, stats);
+}
+};  // namespace alg
+
+#endif  // !__ALG_SORT_SORT_HPP__
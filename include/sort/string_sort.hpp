@@ -0,0 +1,225 @@
+#ifndef __ALG_SORT_STRING_SORT_HPP__
+#define __ALG_SORT_STRING_SORT_HPP__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <random/random.hpp>
+
+namespace alg {
+/*
+ * three-way string quick sort (multikey quick sort)
+ * partitions on the `d`-th character only, so a shared prefix is examined
+ * once per level instead of once per compare.
+ *
+ * optionally fills `lcp[i]`, the length of the longest common prefix of
+ * `a[i - 1]` and `a[i]` after sorting (`lcp[0] = 0`). it is a by-product of
+ * the partitioning: neighbours across a partition boundary at depth `d`
+ * share exactly `d` characters.
+ */
+class Quick3String {
+ protected:
+  using Vector = std::vector<std::string>;
+  using Lcp = std::vector<size_t>;
+
+ public:
+  static void sort(Vector& a) {
+    Random<std::string>::shuffle(a);
+    if (!a.empty()) {
+      sort(a, 0, a.size() - 1, 0, nullptr);
+    }
+  }
+
+  static void sort(Vector& a, Lcp& lcp) {
+    Random<std::string>::shuffle(a);
+    lcp.assign(a.size(), 0);
+    if (!a.empty()) {
+      sort(a, 0, a.size() - 1, 0, &lcp);
+    }
+  }
+
+ protected:
+  static constexpr size_t INSERTION_CUTOFF = 8;
+
+  // `d`-th character, -1 after the end
+  static int char_at(std::string const& s, size_t const d) {
+    return d < s.size() ? static_cast<uint8_t>(s[d]) : -1;
+  }
+
+  // all strings of `a[lo..hi]` share their first `d` characters.
+  // `lcp[lo]` is left to the caller.
+  static void sort(Vector& a,
+                   size_t const lo,
+                   size_t const hi,
+                   size_t const d,
+                   Lcp* lcp) {
+    if (hi <= lo) {
+      return;
+    }
+    if (hi - lo < INSERTION_CUTOFF) {
+      insertion(a, lo, hi, d, lcp);
+      return;
+    }
+    size_t lt = lo, i = lo + 1, gt = hi;
+    int const v = char_at(a[lo], d);
+    while (i <= gt) {
+      int const t = char_at(a[i], d);
+      if (t < v) {
+        std::swap(a[lt++], a[i++]);
+      } else if (t > v) {
+        std::swap(a[i], a[gt--]);
+      } else {
+        i++;
+      }
+    }
+    // a[lo..lt-1] < v = a[lt..gt] < a[gt+1..hi] at `d`
+    if (lt > lo) {
+      sort(a, lo, lt - 1, d, lcp);
+      set_lcp(lcp, lt, d);
+    }
+    if (v >= 0) {
+      sort(a, lt, gt, d + 1, lcp);
+    } else {
+      // all ended at `d`: equal strings
+      for (size_t k = lt + 1; k <= gt; k++) {
+        set_lcp(lcp, k, d);
+      }
+    }
+    if (gt < hi) {
+      set_lcp(lcp, gt + 1, d);
+      sort(a, gt + 1, hi, d, lcp);
+    }
+  }
+
+  static void insertion(Vector& a,
+                        size_t const lo,
+                        size_t const hi,
+                        size_t const d,
+                        Lcp* lcp) {
+    for (size_t i = lo + 1; i <= hi; i++) {
+      for (size_t j = i; j > lo && less(a[j], a[j - 1], d); j--) {
+        std::swap(a[j], a[j - 1]);
+      }
+    }
+    if (lcp != nullptr) {
+      for (size_t i = lo + 1; i <= hi; i++) {
+        (*lcp)[i] = d + common_prefix(a[i - 1], a[i], d);
+      }
+    }
+  }
+
+  // `v` < `w`, both known to be equal before `d`
+  static bool less(std::string const& v,
+                   std::string const& w,
+                   size_t const d) {
+    return v.compare(d, std::string::npos, w, d, std::string::npos) < 0;
+  }
+
+  static size_t common_prefix(std::string const& v,
+                              std::string const& w,
+                              size_t const d) {
+    size_t const n = std::min(v.size(), w.size());
+    size_t i = d;
+    while (i < n && v[i] == w[i]) {
+      i++;
+    }
+    return i - d;
+  }
+
+  static void set_lcp(Lcp* lcp, size_t const i, size_t const d) {
+    if (lcp != nullptr) {
+      (*lcp)[i] = d;
+    }
+  }
+};
+
+/*
+ * MSD string sort
+ * key-indexed counting on the `d`-th character, then recursion into each of
+ * the `R` buckets. small buckets, where `R` counters would dominate, are
+ * handed over to `Quick3String`.
+ *
+ * fills the same optional `lcp` array as `Quick3String`.
+ */
+class MSD : Quick3String {
+ public:
+  static void sort(Vector& a) {
+    if (!a.empty()) {
+      Vector aux(a.size());
+      sort(a, aux, 0, a.size() - 1, 0, nullptr);
+    }
+  }
+
+  static void sort(Vector& a, Lcp& lcp) {
+    lcp.assign(a.size(), 0);
+    if (!a.empty()) {
+      Vector aux(a.size());
+      sort(a, aux, 0, a.size() - 1, 0, &lcp);
+    }
+  }
+
+ private:
+  static constexpr size_t R = 256;
+  static constexpr size_t QUICK3_CUTOFF = 64;
+
+  static void sort(Vector& a,
+                   Vector& aux,
+                   size_t const lo,
+                   size_t const hi,
+                   size_t d,
+                   Lcp* lcp) {
+    if (hi <= lo) {
+      return;
+    }
+    if (hi - lo < QUICK3_CUTOFF) {
+      Quick3String::sort(a, lo, hi, d, lcp);
+      return;
+    }
+    // count[c + 2] for character `c`, -1 (end of string) included
+    std::array<size_t, R + 2> count{};
+    while (true) {
+      for (size_t i = lo; i <= hi; i++) {
+        count[char_at(a[i], d) + 2]++;
+      }
+      // a character shared by the whole subarray: no need to move anything
+      int const c = char_at(a[lo], d);
+      if (c < 0 || count[c + 2] != hi - lo + 1) {
+        break;
+      }
+      count[c + 2] = 0;
+      d++;
+    }
+    for (size_t r = 0; r < R + 1; r++) {
+      count[r + 1] += count[r];
+    }
+    for (size_t i = lo; i <= hi; i++) {
+      aux[count[char_at(a[i], d) + 1]++] = std::move(a[i]);
+    }
+    for (size_t i = lo; i <= hi; i++) {
+      a[i] = std::move(aux[i - lo]);
+    }
+    // now strings ended at `d` are in `[lo, lo + count[0])`, and those with
+    // character `r` in `[lo + count[r], lo + count[r + 1])`
+    for (size_t k = lo + 1; k < lo + count[0]; k++) {
+      set_lcp(lcp, k, d);
+    }
+    for (size_t r = 0; r < R; r++) {
+      size_t const b = lo + count[r], e = lo + count[r + 1];
+      if (b == e) {
+        continue;
+      }
+      if (b > lo) {
+        set_lcp(lcp, b, d);
+      }
+      sort(a, aux, b, e - 1, d + 1, lcp);
+    }
+  }
+};
+};  // namespace alg
+
+#endif  // !__ALG_SORT_STRING_SORT_HPP__
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <parallel/multiqueue.hpp>
+#include <parallel/scheduler.hpp>
+#include <sort/heap.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(multiqueue, sequential_push_pop) {
+  alg::MultiQueue<int> mq(4);
+  ASSERT_EQ(mq.lanes(), 8);
+  ASSERT_TRUE(mq.empty());
+  ASSERT_FALSE(mq.try_pop().has_value());
+  ASSERT_THROW(mq.pop(), std::runtime_error);
+
+  int const n = 10000;
+  for (int i = 0; i < n; i++) {
+    mq.push(i);
+  }
+  ASSERT_EQ(mq.size(), n);
+
+  std::vector<int> output;
+  int64_t rank_error = 0;
+  while (!mq.empty()) {
+    int const x = mq.pop();
+    rank_error += x - static_cast<int>(output.size()) > 0
+                      ? x - static_cast<int>(output.size())
+                      : static_cast<int>(output.size()) - x;
+    output.push_back(x);
+  }
+  std::sort(output.begin(), output.end());
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(output[i], i);
+  }
+  // relaxed, but close to the true order
+  std::cout << "mean rank error: " << double(rank_error) / n << "\n";
+  ASSERT_LT(rank_error, int64_t(n) * 64);
+}
+
+static bool less_pointee(std::unique_ptr<int> const& t1,
+                         std::unique_ptr<int> const& t2) {
+  return *t1 < *t2;
+}
+
+TEST(multiqueue, move_only_items) {
+  alg::MultiQueue<std::unique_ptr<int>, less_pointee> mq(2, 1);
+  mq.push(std::make_unique<int>(2));
+  mq.push(std::make_unique<int>(1));
+  int const x = *mq.pop();
+  int const y = *mq.pop();
+  ASSERT_EQ(x + y, 3);
+  ASSERT_TRUE(mq.empty());
+}
+
+TEST(multiqueue, concurrent_push_pop) {
+  size_t const n_threads = 4;
+  int const per_thread = 20000;
+  alg::Scheduler sched(n_threads);
+  alg::MultiQueue<int> mq(n_threads);
+
+  // every item pushed is popped exactly once
+  std::vector<std::atomic<int>> seen(n_threads * per_thread);
+  alg::TaskGroup tg(sched);
+  for (size_t t = 0; t < n_threads; t++) {
+    tg.run([&, t] {
+      for (int i = 0; i < per_thread; i++) {
+        mq.push(static_cast<int>(t) * per_thread + i);
+        if (i % 2 == 1) {
+          seen[mq.pop()]++;
+        }
+      }
+    });
+  }
+  tg.wait();
+  while (std::optional<int> x = mq.try_pop()) {
+    seen[*x]++;
+  }
+  for (auto const& s : seen) {
+    ASSERT_EQ(s.load(), 1);
+  }
+  ASSERT_TRUE(mq.empty());
+}
+
+TEST(multiqueue, against_locked_priority_queue) {
+  size_t const n_threads = 4;
+  int const ops = 100000;
+  alg::Scheduler sched(n_threads);
+  alg::Timer<HightResolutionClock> timer;
+
+  alg::MultiQueue<int> mq(n_threads);
+  timer.start();
+  {
+    alg::TaskGroup tg(sched);
+    for (size_t t = 0; t < n_threads; t++) {
+      tg.run([&, t] {
+        for (int i = 0; i < ops; i++) {
+          mq.push(i * static_cast<int>(n_threads) + static_cast<int>(t));
+          mq.pop();
+        }
+      });
+    }
+    tg.wait();
+  }
+  timer.stop();
+  std::cout << "MultiQueue: " << timer.miliseconds() << "ms\n";
+
+  alg::PriorityQueue<int> pq;
+  std::mutex mu;
+  timer.reset();
+  timer.start();
+  {
+    alg::TaskGroup tg(sched);
+    for (size_t t = 0; t < n_threads; t++) {
+      tg.run([&, t] {
+        for (int i = 0; i < ops; i++) {
+          std::lock_guard<std::mutex> lk(mu);
+          pq.push(i * static_cast<int>(n_threads) + static_cast<int>(t));
+          pq.pop();
+        }
+      });
+    }
+    tg.wait();
+  }
+  timer.stop();
+  std::cout << "locked PriorityQueue: " << timer.miliseconds() << "ms\n";
+  ASSERT_TRUE(mq.empty());
+  ASSERT_EQ(pq.size(), 0);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+static uint64_t fib(alg::Scheduler& sched, uint64_t const n) {
+  if (n < 2) {
+    return n;
+  }
+  uint64_t x = 0, y = 0;
+  alg::TaskGroup tg(sched);
+  tg.run([&] { x = fib(sched, n - 1); });
+  y = fib(sched, n - 2);
+  tg.wait();
+  return x + y;
+}
+
+TEST(task_group, nested_fork_join) {
+  for (size_t n_threads : {1, 2, 4, 8}) {
+    alg::Scheduler sched(n_threads);
+    ASSERT_EQ(sched.concurrency(), n_threads);
+
+    alg::Timer<HightResolutionClock> timer;
+    timer.start();
+    uint64_t const output = fib(sched, 20);
+    timer.stop();
+
+    std::cout << n_threads << " threads, elapsed time: " << timer.miliseconds()
+              << "ms\n";
+    ASSERT_EQ(output, 6765);
+  }
+}
+
+TEST(task_group, all_tasks_run) {
+  alg::Scheduler sched(4);
+  std::vector<std::atomic<int>> hits(10000);
+  alg::TaskGroup tg(sched);
+  for (size_t i = 0; i < hits.size(); i++) {
+    tg.run([&hits, i] { hits[i]++; });
+  }
+  tg.wait();
+  for (auto const& h : hits) {
+    ASSERT_EQ(h, 1);
+  }
+}
+
+TEST(task_group, exception_rethrown_by_wait) {
+  alg::Scheduler sched(2);
+  alg::TaskGroup tg(sched);
+  std::atomic<int> done = 0;
+  for (int i = 0; i < 100; i++) {
+    tg.run([&done, i] {
+      if (i == 42) {
+        throw std::runtime_error("task failed");
+      }
+      done++;
+    });
+  }
+  ASSERT_THROW(tg.wait(), std::runtime_error);
+  ASSERT_EQ(done, 99);
+  // group is reusable after the error was reported
+  tg.run([&done] { done++; });
+  tg.wait();
+  ASSERT_EQ(done, 100);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <random/random.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+// every one of `n` buckets drawn within 5% of its expected share
+template <typename G>
+static void expect_uniform_buckets(G& g, uint64_t const n) {
+  size_t const draws = 200000 * n;
+  std::vector<size_t> count(n, 0);
+  for (size_t i = 0; i < draws; i++) {
+    uint64_t const r = alg::bounded(g, n);
+    ASSERT_LT(r, n);
+    count[r]++;
+  }
+  for (size_t const c : count) {
+    ASSERT_NEAR(static_cast<double>(c), draws / n, 0.05 * draws / n);
+  }
+}
+
+TEST(prng, reference_outputs_and_seeding) {
+  // first word of SplitMix64 from 0, as published with the algorithm
+  alg::SplitMix64 sm(0);
+  ASSERT_EQ(sm(), 0xe220a8397b1dcdaf);
+
+  alg::Xoshiro256 x1(42), x2(42), x3(43);
+  alg::Pcg64 p1(42), p2(42), p3(42, 1);
+  alg::Wyrand w1(42), w2(42);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(x1(), x2());
+    ASSERT_EQ(p1(), p2());
+    ASSERT_EQ(w1(), w2());
+  }
+  ASSERT_NE(x1(), x3());
+  ASSERT_NE(p1(), p3());
+
+  // streams after a jump do not overlap the first words
+  alg::Xoshiro256 j1(7), j2(7);
+  j2.jump();
+  std::vector<uint64_t> s1(1000), s2(1000);
+  std::generate(s1.begin(), s1.end(), j1);
+  std::generate(s2.begin(), s2.end(), j2);
+  std::sort(s1.begin(), s1.end());
+  for (uint64_t const x : s2) {
+    ASSERT_FALSE(std::binary_search(s1.begin(), s1.end(), x));
+  }
+}
+
+TEST(prng, bounded_is_uniform) {
+  alg::Xoshiro256 x(1);
+  alg::Pcg64 p(2);
+  alg::Wyrand w(3);
+  std::mt19937_64 mt(4);
+  for (uint64_t const n : {1, 2, 3, 7, 10}) {
+    expect_uniform_buckets(x, n);
+    expect_uniform_buckets(p, n);
+    expect_uniform_buckets(w, n);
+    expect_uniform_buckets(mt, n);
+  }
+
+  // 64-bit ranges: the top quarter of `3 * 2^62` holds a third of the draws
+  uint64_t const n = 3 * (uint64_t(1) << 62);
+  size_t top = 0;
+  for (int i = 0; i < 300000; i++) {
+    uint64_t const r = alg::bounded(x, n);
+    ASSERT_LT(r, n);
+    top += r >= 2 * (uint64_t(1) << 62);
+  }
+  ASSERT_NEAR(top, 100000, 2000);
+}
+
+TEST(prng, uniform_over_whole_ranges) {
+  alg::Wyrand g(5);
+  std::vector<size_t> count(256, 0);
+  for (int i = 0; i < 256 * 1000; i++) {
+    count[alg::uniform<int8_t>(g, -128, 127) + 128]++;
+  }
+  ASSERT_GT(*std::min_element(count.begin(), count.end()), 800);
+
+  int64_t const lo = std::numeric_limits<int64_t>::min();
+  int64_t const hi = std::numeric_limits<int64_t>::max();
+  size_t negative = 0;
+  for (int i = 0; i < 100000; i++) {
+    negative += alg::uniform(g, lo, hi) < 0;
+  }
+  ASSERT_NEAR(negative, 50000, 1000);
+  ASSERT_EQ(alg::uniform(g, -3, -3), -3);
+
+  alg::RandIntGen<int> gen(-5, 5, 9), same(-5, 5, 9);
+  for (int i = 0; i < 1000; i++) {
+    int const r = gen.gen();
+    ASSERT_GE(r, -5);
+    ASSERT_LE(r, 5);
+    ASSERT_EQ(r, same.gen());
+  }
+  gen.rest(100, 100);
+  ASSERT_EQ(gen.gen(), 100);
+}
+
+TEST(shuffle, seeded_shuffle_is_reproducible_permutation) {
+  std::vector<int> input(1000);
+  std::iota(input.begin(), input.end(), 0);
+  auto a = input, b = input;
+  alg::Xoshiro256 g1(11), g2(11);
+  alg::Random<int>::shuffle(a, g1);
+  alg::Random<int>::shuffle(b, g2);
+  ASSERT_EQ(a, b);
+  ASSERT_NE(a, input);
+
+  alg::seed_thread_rng(12);
+  alg::Random<int>::shuffle(a);
+  alg::seed_thread_rng(12);
+  alg::Random<int>::shuffle(b);
+  ASSERT_EQ(a, b);
+  std::sort(a.begin(), a.end());
+  ASSERT_EQ(a, input);
+}
+
+TEST(shuffle, every_order_of_three_equally_likely) {
+  alg::Xoshiro256 g(13);
+  std::vector<size_t> count(6, 0);
+  for (int i = 0; i < 600000; i++) {
+    std::vector<int> a = {0, 1, 2};
+    alg::Random<int>::shuffle(a, g);
+    std::vector<int> order = {0, 1, 2};
+    size_t rank = 0;
+    while (order != a) {
+      std::next_permutation(order.begin(), order.end());
+      rank++;
+    }
+    count[rank]++;
+  }
+  for (size_t const c : count) {
+    ASSERT_NEAR(c, 100000, 2000);
+  }
+}
+
+TEST(shuffle, parallel_shuffle_against_knuth_shuffle) {
+  size_t const n = 1 << 22;
+  std::vector<uint32_t> input(n);
+  std::iota(input.begin(), input.end(), 0);
+
+  auto std_shuffled = input;
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  std::shuffle(std_shuffled.begin(), std_shuffled.end(),
+               std::mt19937(std::random_device{}()));
+  timer.stop();
+  std::cout << "std::shuffle with mt19937, elapsed time: "
+            << timer.miliseconds() << "ms\n";
+
+  auto knuth = input;
+  timer.reset();
+  timer.start();
+  alg::Random<uint32_t>::shuffle(knuth);
+  timer.stop();
+  std::cout << "Knuth shuffle, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  auto parallel = input;
+  alg::Scheduler sched(4);
+  timer.reset();
+  timer.start();
+  alg::Random<uint32_t>::parallel_shuffle(parallel, 21, sched);
+  timer.stop();
+  std::cout << "parallel shuffle, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  // the order depends on the seed only, not on the threads
+  auto serial = input;
+  alg::Scheduler one(1);
+  alg::Random<uint32_t>::parallel_shuffle(serial, 21, one);
+  ASSERT_EQ(serial, parallel);
+
+  // items of the first quarter spread evenly over the four quarters,
+  // and about half of the neighbours are in order
+  std::vector<size_t> quarter(4, 0);
+  size_t ascents = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (parallel[i] < n / 4) {
+      quarter[i / (n / 4)]++;
+    }
+    ascents += i + 1 < n && parallel[i] < parallel[i + 1];
+  }
+  for (size_t const q : quarter) {
+    ASSERT_NEAR(q, n / 16, n / 400);
+  }
+  ASSERT_NEAR(ascents, n / 2, n / 200);
+
+  std::sort(parallel.begin(), parallel.end());
+  ASSERT_EQ(parallel, input);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <random/sampling.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(reservoir, every_item_equally_likely) {
+  size_t const n = 100, k = 10, rounds = 20000;
+  std::vector<int> input(n);
+  std::iota(input.begin(), input.end(), 0);
+  std::vector<size_t> pushed(n, 0), ranged(n, 0);
+  alg::Xoshiro256 seeds(1);
+  for (size_t r = 0; r < rounds; r++) {
+    alg::Reservoir<int> one_by_one(k, alg::Xoshiro256(seeds()));
+    for (int const x : input) {
+      one_by_one.push(x);
+    }
+    alg::Reservoir<int> at_once(k, alg::Xoshiro256(seeds()));
+    at_once.push(input.begin(), input.end());
+    ASSERT_EQ(one_by_one.items().size(), k);
+    ASSERT_EQ(at_once.items().size(), k);
+    ASSERT_EQ(at_once.seen(), n);
+    for (size_t i = 0; i < k; i++) {
+      pushed[one_by_one.items()[i]]++;
+      ranged[at_once.items()[i]]++;
+    }
+  }
+  double const expect = static_cast<double>(rounds * k) / n;
+  for (size_t i = 0; i < n; i++) {
+    ASSERT_NEAR(pushed[i], expect, 0.1 * expect);
+    ASSERT_NEAR(ranged[i], expect, 0.1 * expect);
+  }
+}
+
+TEST(reservoir, short_streams_and_skipping) {
+  alg::Reservoir<int> r(10);
+  r.push(3);
+  r.push(4);
+  ASSERT_EQ(r.items(), std::vector<int>({3, 4}));
+
+  alg::Reservoir<int> none(0);
+  none.push(1);
+  ASSERT_TRUE(none.items().empty());
+  ASSERT_EQ(none.seen(), 1);
+
+  // a range is jumped over: items between the taken ones are never read
+  std::vector<uint32_t> input(1 << 24);
+  std::iota(input.begin(), input.end(), 0);
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::Reservoir<uint32_t> sample(100);
+  sample.push(input.begin(), input.end());
+  timer.stop();
+  std::cout << "reservoir of 100 among 16M, elapsed time: "
+            << timer.miliseconds() << "ms\n";
+  ASSERT_EQ(sample.items().size(), 100);
+  ASSERT_EQ(sample.seen(), input.size());
+  // most of the sample comes from beyond the first 1%
+  size_t late = 0;
+  for (uint32_t const x : sample.items()) {
+    late += x >= input.size() / 100;
+  }
+  ASSERT_GT(late, 80);
+}
+
+TEST(alias_table, draws_follow_weights) {
+  alg::AliasTable table(std::vector<double>({1, 2, 3, 4, 0}));
+  ASSERT_EQ(table.size(), 5);
+  alg::Wyrand g(2);
+  size_t const draws = 1000000;
+  std::vector<size_t> count(5, 0);
+  for (size_t i = 0; i < draws; i++) {
+    count[table(g)]++;
+  }
+  for (size_t i = 0; i < 4; i++) {
+    double const expect = draws * (i + 1) / 10.0;
+    ASSERT_NEAR(count[i], expect, 0.02 * expect);
+  }
+  ASSERT_EQ(count[4], 0);
+
+  ASSERT_THROW(alg::AliasTable(std::vector<double>()), std::runtime_error);
+  ASSERT_THROW(alg::AliasTable(std::vector<double>({0, 0})),
+               std::runtime_error);
+  ASSERT_THROW(alg::AliasTable(std::vector<double>({1, -1})),
+               std::runtime_error);
+}
+
+TEST(zipf, draws_follow_power_law) {
+  for (double const s : {0.5, 1.0, 1.2, 2.0}) {
+    uint64_t const n = 10;
+    alg::Zipf zipf(n, s);
+    double norm = 0;
+    for (uint64_t k = 1; k <= n; k++) {
+      norm += std::pow(static_cast<double>(k), -s);
+    }
+    alg::Xoshiro256 g(3);
+    size_t const draws = 1000000;
+    std::vector<size_t> count(n + 1, 0);
+    for (size_t i = 0; i < draws; i++) {
+      uint64_t const k = zipf(g);
+      ASSERT_GE(k, 1);
+      ASSERT_LE(k, n);
+      count[k]++;
+    }
+    for (uint64_t k = 1; k <= n; k++) {
+      double const expect =
+          draws * std::pow(static_cast<double>(k), -s) / norm;
+      ASSERT_NEAR(count[k], expect, 0.03 * expect) << "s = " << s;
+    }
+  }
+  // a huge support costs nothing
+  alg::Zipf wide(uint64_t(1) << 40, 1.1);
+  alg::Xoshiro256 g(4);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_LE(wide(g), uint64_t(1) << 40);
+  }
+  ASSERT_THROW(alg::Zipf(0, 1.0), std::runtime_error);
+  ASSERT_THROW(alg::Zipf(10, 0.0), std::runtime_error);
+}
+
+TEST(zipf, parallel_generate_depends_on_seed_only) {
+  alg::Zipf zipf(1000000, 0.99);
+  std::vector<uint32_t> a(1 << 20), b(1 << 20);
+  alg::Scheduler four(4), one(1);
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::parallel_generate(a, 5, zipf, four);
+  timer.stop();
+  std::cout << "zipf of 1M, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  alg::parallel_generate(b, 5, zipf, one);
+  ASSERT_EQ(a, b);
+  // the rank 1 key is the most frequent by far
+  size_t const ones = std::count(a.begin(), a.end(), 1u);
+  size_t const twos = std::count(a.begin(), a.end(), 2u);
+  ASSERT_NEAR(static_cast<double>(ones) / twos, std::pow(2.0, 0.99), 0.1);
+
+  alg::AliasTable coin(std::vector<double>({1, 3}));
+  alg::parallel_generate(b, 6, coin, four);
+  size_t const heads = std::count(b.begin(), b.end(), 1u);
+  ASSERT_NEAR(heads, 0.75 * b.size(), 0.01 * b.size());
+}
+
+TEST(bernoulli_skip, kept_items_at_rate_p) {
+  alg::Xoshiro256 g(7);
+  size_t const n = 1000000;
+  alg::BernoulliSkip sampler(0.01);
+  auto const kept = sampler.indices(n, g);
+  ASSERT_NEAR(kept.size(), 10000, 400);
+  ASSERT_TRUE(std::is_sorted(kept.begin(), kept.end()));
+  ASSERT_EQ(std::adjacent_find(kept.begin(), kept.end()), kept.end());
+  ASSERT_LT(kept.back(), n);
+
+  // each position equally likely: kept in the first and the second half
+  size_t const first_half = std::count_if(
+      kept.begin(), kept.end(), [n](size_t const i) { return i < n / 2; });
+  ASSERT_NEAR(first_half, kept.size() / 2, 300);
+
+  ASSERT_EQ(alg::BernoulliSkip(1.0).indices(5, g),
+            std::vector<size_t>({0, 1, 2, 3, 4}));
+  ASSERT_TRUE(alg::BernoulliSkip(0.0).indices(5, g).empty());
+  ASSERT_THROW(alg::BernoulliSkip(1.5), std::runtime_error);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
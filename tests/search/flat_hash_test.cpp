@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <limits>
+#include <random/random.hpp>
+#include <search/common.hpp>
+#include <search/flat_hash.hpp>
+#include <search/linear_probing.hpp>
+#include <string>
+#include <time/timer.hpp>
+#include <tuple>
+#include <vector>
+#include "sort/quick.hpp"
+
+TEST(put_and_get, small_case) {
+  auto hash = alg::Hash<int>::hash;
+  alg::FlatHash<int, int> st(hash);
+  std::vector<std::tuple<int, int>> input = {{1, 0}, {2, 0}, {3, 0}};
+  int cnt = 0;
+
+  // consistency of size, get and put
+  for (auto const& [key, val] : input) {
+    ASSERT_EQ(cnt, st.size());
+    ASSERT_FALSE(st.contains(key));
+    st.put(key, val);
+    ASSERT_EQ(++cnt, st.size());
+    ASSERT_TRUE(st.contains(key));
+    ASSERT_EQ(val, st.get(key).value());
+  }
+
+  // value update
+  for (auto const& [key, val] : input) {
+    st.put(key, val + 1);
+    ASSERT_EQ(cnt, st.size());
+    ASSERT_EQ(val + 1, st.get(key).value());
+  }
+  ASSERT_FALSE(st.get(4).has_value());
+}
+
+TEST(del, small_case) {
+  alg::FlatHash<int, int> st(alg::Hash<int>::hash);
+  std::vector<std::tuple<int, int>> input = {{1, 0}, {2, 0}, {3, 0}};
+  int cnt = 0;
+
+  for (auto const& [key, val] : input) {
+    st.put(key, val);
+    ASSERT_EQ(++cnt, st.size());
+  }
+
+  // delete
+  for (auto const& [key, _val] : input) {
+    st.del(key);
+    ASSERT_FALSE(st.contains(key));
+    ASSERT_EQ(st.size(), --cnt);
+  }
+  st.del(0);  // stdout, error message
+  st.del(1);  // stdout, error message
+}
+
+TEST(all, string_keys_and_copies) {
+  alg::FlatHash<std::string, std::string> st(alg::Hash<std::string>::hash);
+  for (int i = 0; i < 1000; i++) {
+    st.put("key" + std::to_string(i), std::string(i % 50, 'v'));
+  }
+  auto copy = st;
+  for (int i = 0; i < 1000; i += 2) {
+    st.del("key" + std::to_string(i));
+  }
+  ASSERT_EQ(st.size(), 500);
+  ASSERT_EQ(copy.size(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    std::string const key = "key" + std::to_string(i);
+    ASSERT_EQ(st.contains(key), i % 2 == 1);
+    ASSERT_EQ(copy.get(key).value(), std::string(i % 50, 'v'));
+  }
+
+  auto moved = std::move(copy);
+  ASSERT_EQ(moved.size(), 1000);
+  copy = moved;
+  copy.put("new", "value");
+  ASSERT_EQ(copy.size(), 1001);
+  ASSERT_FALSE(moved.contains("new"));
+}
+
+TEST(all, colliding_hashes) {
+  // every key in the same probe sequence with the same control byte
+  auto same = [](int const&) { return 7; };
+  alg::FlatHash<int, int, decltype(same), std::equal_to<int>> st(same);
+  int const n = 200;
+  for (int i = 0; i < n; i++) {
+    st.put(i, i * i);
+  }
+  for (int i = 0; i < n; i += 3) {
+    st.del(i);
+  }
+  for (int i = 0; i < n; i++) {
+    if (i % 3 == 0) {
+      ASSERT_FALSE(st.contains(i));
+    } else {
+      ASSERT_EQ(st.get(i).value(), i * i);
+    }
+  }
+}
+
+TEST(all, churn_with_tombstones) {
+  // puts and deletes at a steady size, the table must not keep growing
+  alg::FlatHash<int, int, alg::Hasher<int>, std::equal_to<int>> st;
+  int const live = 1000;
+  for (int i = 0; i < 200000; i++) {
+    st.put(i, i);
+    if (i >= live) {
+      st.del(i - live);
+    }
+    ASSERT_EQ(st.size(), std::min(i + 1, live));
+  }
+  for (int i = 200000 - live; i < 200000; i++) {
+    ASSERT_EQ(st.get(i).value(), i);
+  }
+  ASSERT_FALSE(st.contains(200000 - live - 1));
+}
+
+TEST(all, random) {
+  auto st = alg::FlatHash<int, int>(alg::Hash<int>::hash);
+  int const lo = 1000, hi = 10000;
+  int const val_lo = 0, val_hi = std::numeric_limits<int>::max();
+  auto generator = alg::RandIntGen<int>(lo, hi);
+  int const n = generator.gen();
+  std::cout << "n: " << n << '\n';
+  auto ikeys = std::vector<int>();
+
+  auto key_generator = alg::RandIntGen<>(val_lo, val_hi);
+  for (int i = 0; i < n; i++) {
+    int const key = key_generator.gen();
+    if (!st.contains(key)) {
+      st.put(key, 0);
+      ikeys.push_back(key);
+    }
+  }
+
+  auto okeys = st.keys();
+  ASSERT_EQ(okeys.size(), ikeys.size());
+  alg::Quick<int>::sort(ikeys);
+  alg::Quick<int>::sort(okeys);
+  for (size_t i = 0; i < okeys.size(); i++) {
+    ASSERT_EQ(ikeys[i], okeys[i]);
+  }
+
+  for (size_t i = 0; i < ikeys.size(); i += 2) {
+    st.del(ikeys[i]);
+  }
+  for (size_t i = 0; i < ikeys.size(); i++) {
+    ASSERT_EQ(st.contains(ikeys[i]), i % 2 == 1);
+  }
+}
+
+TEST(all, against_linear_probing) {
+  int const n = 1 << 20;
+  auto generator = alg::RandIntGen<int>(0, std::numeric_limits<int>::max());
+  auto ikeys = std::vector<int>(n);
+  for (auto& key : ikeys) {
+    key = generator.gen();
+  }
+  auto misses = std::vector<int>(n);
+  for (auto& key : misses) {
+    key = -generator.gen() - 1;
+  }
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::LinearProbing<int, int, alg::Hasher<int>, std::equal_to<int>> lp;
+  for (int i = 0; i < n; i++) {
+    lp.put(ikeys[i], i);
+  }
+  int found = 0;
+  for (int const key : ikeys) {
+    found += lp.contains(key);
+  }
+  for (int const key : misses) {
+    found += lp.contains(key);
+  }
+  timer.stop();
+  std::cout << "linear probing, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+  ASSERT_EQ(found, n);
+
+  timer.reset();
+  timer.start();
+  alg::FlatHash<int, int, alg::Hasher<int>, std::equal_to<int>> st;
+  for (int i = 0; i < n; i++) {
+    st.put(ikeys[i], i);
+  }
+  found = 0;
+  for (int const key : ikeys) {
+    found += st.contains(key);
+  }
+  for (int const key : misses) {
+    found += st.contains(key);
+  }
+  timer.stop();
+  std::cout << "flat hash, elapsed time: " << timer.miliseconds() << "ms\n";
+  ASSERT_EQ(found, n);
+
+  ASSERT_EQ(st.size(), lp.size());
+  for (int const key : ikeys) {
+    ASSERT_EQ(st.get(key), lp.get(key));
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
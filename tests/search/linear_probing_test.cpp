@@ -4,6 +4,7 @@
 #include <random/random.hpp>
 #include <search/common.hpp>
 #include <search/linear_probing.hpp>
+#include <time/timer.hpp>
 #include "sort/quick.hpp"
 
 TEST(put_and_get, small_case) {
@@ -104,6 +105,46 @@ TEST(all, random) {
   }
 }
 
+TEST(all, function_object_hasher) {
+  int const n = 1 << 18;
+  auto generator = alg::RandIntGen<int>(0, std::numeric_limits<int>::max());
+  auto ikeys = std::vector<int>(n);
+  for (auto& key : ikeys) {
+    key = generator.gen();
+  }
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::LinearProbing<int, int> pointer_st(alg::Hash<int>::hash);
+  for (int i = 0; i < n; i++) {
+    pointer_st.put(ikeys[i], i);
+  }
+  for (int const key : ikeys) {
+    ASSERT_TRUE(pointer_st.contains(key));
+  }
+  timer.stop();
+  std::cout << "function pointer, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  timer.reset();
+  timer.start();
+  alg::LinearProbing<int, int, alg::Hasher<int>, std::equal_to<int>> st;
+  for (int i = 0; i < n; i++) {
+    st.put(ikeys[i], i);
+  }
+  for (int const key : ikeys) {
+    ASSERT_TRUE(st.contains(key));
+  }
+  timer.stop();
+  std::cout << "function object, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  ASSERT_EQ(st.size(), pointer_st.size());
+  for (int const key : ikeys) {
+    ASSERT_EQ(st.get(key), pointer_st.get(key));
+  }
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -316,6 +316,26 @@ TEST(init, test_wrap_class) {
   alg::LLRB<WrapClass, int> bst;
 }
 
+// three-way comparator as a function object
+struct ReversedOrder {
+  int operator()(int const& t1, int const& t2) const {
+    return t1 < t2 ? 1 : (t1 > t2 ? -1 : 0);
+  }
+};
+
+TEST(init, test_function_object_comparator) {
+  alg::LLRB<int, int, ReversedOrder> bst;
+  for (int i = 0; i < 100; i++) {
+    bst.put(i, i * i);
+  }
+  ASSERT_EQ(bst.size(), 100);
+  ASSERT_EQ(bst.get(7).value(), 49);
+  auto const keys = bst.keys();
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(keys[i], 99 - i);
+  }
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -3,6 +3,7 @@
 #include <random/random.hpp>
 #include <search/common.hpp>
 #include <search/seperate_chaining.hpp>
+#include <string>
 #include "sort/quick.hpp"
 
 TEST(put_and_get, small_case) {
@@ -103,6 +104,22 @@ TEST(all, random) {
   }
 }
 
+TEST(all, function_object_hasher) {
+  alg::SeperateChaining<std::string, int, alg::Hasher<std::string>,
+                        std::equal_to<std::string>>
+      st;
+  std::vector<std::string> const input = {"apple", "banana", "cat", "dog"};
+  for (size_t i = 0; i < input.size(); i++) {
+    st.put(input[i], i);
+  }
+  ASSERT_EQ(st.size(), 4);
+  for (size_t i = 0; i < input.size(); i++) {
+    ASSERT_EQ(st.get(input[i]).value(), i);
+  }
+  st.del("cat");
+  ASSERT_FALSE(st.contains("cat"));
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
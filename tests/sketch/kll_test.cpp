@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <random/random.hpp>
+#include <sketch/kll.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+// `x`'s rank in sorted `a`, as a fraction
+static double true_rank(std::vector<int> const& a, int const x) {
+  return static_cast<double>(std::lower_bound(a.begin(), a.end(), x) -
+                             a.begin()) /
+         static_cast<double>(a.size());
+}
+
+TEST(kll, empty_and_invalid) {
+  alg::KLL<int> s;
+  ASSERT_TRUE(s.empty());
+  ASSERT_THROW(s.quantile(0.5), std::runtime_error);
+  ASSERT_THROW(s.min(), std::runtime_error);
+  ASSERT_THROW(alg::KLL<int>(1), std::runtime_error);
+  s.add(3);
+  ASSERT_THROW(s.quantile(1.5), std::runtime_error);
+  ASSERT_EQ(s.quantile(0.5), 3);
+}
+
+TEST(kll, small_stream_is_exact) {
+  alg::KLL<int> s(200, 1);
+  for (int i = 99; i >= 0; i--) {
+    s.add(i);
+  }
+  ASSERT_EQ(s.count(), 100);
+  ASSERT_EQ(s.size(), 100);
+  ASSERT_EQ(s.min(), 0);
+  ASSERT_EQ(s.max(), 99);
+  ASSERT_EQ(s.quantile(0.5), 50);
+  ASSERT_EQ(s.rank(10), 10);
+}
+
+TEST(kll, rank_error_within_bound) {
+  int const n = 1000000;
+  alg::KLL<int> s(200, 7);
+  alg::Xoshiro256 g(7);
+  std::vector<int> a(n);
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  for (int i = 0; i < n; i++) {
+    a[i] = static_cast<int>(alg::bounded(g, 1 << 30));
+    s.add(a[i]);
+  }
+  timer.stop();
+  std::cout << "add: " << timer.miliseconds() << "ms, " << s.size()
+            << " items held\n";
+  ASSERT_LT(s.size(), 1000);
+  std::sort(a.begin(), a.end());
+
+  double worst = 0;
+  for (double q = 0.01; q < 1; q += 0.01) {
+    worst = std::max(worst, std::abs(true_rank(a, s.quantile(q)) - q));
+    int const x = a[static_cast<size_t>(q * n)];
+    double const rank_error =
+        std::abs(static_cast<double>(s.rank(x)) / n - true_rank(a, x));
+    worst = std::max(worst, rank_error);
+  }
+  std::cout << "worst rank error: " << worst << "\n";
+  ASSERT_LT(worst, 0.017);
+  ASSERT_EQ(s.min(), a.front());
+  ASSERT_EQ(s.max(), a.back());
+}
+
+TEST(kll, merge_shards) {
+  int const n = 400000, shards = 4;
+  alg::Scheduler sched(shards);
+  std::vector<int> a(n);
+  for (int i = 0; i < n; i++) {
+    a[i] = i;
+  }
+  alg::Random<int>::shuffle(a);
+
+  std::vector<alg::KLL<int>> parts;
+  for (int t = 0; t < shards; t++) {
+    parts.emplace_back(200, t);
+  }
+  alg::TaskGroup tg(sched);
+  for (int t = 0; t < shards; t++) {
+    tg.run([&, t] {
+      for (int i = t; i < n; i += shards) {
+        parts[t].add(a[i]);
+      }
+    });
+  }
+  tg.wait();
+  alg::KLL<int> s(200, 9);
+  for (auto const& p : parts) {
+    s.merge(p);
+  }
+  ASSERT_EQ(s.count(), n);
+  for (double const q : {0.01, 0.25, 0.5, 0.75, 0.99}) {
+    ASSERT_NEAR(s.quantile(q), q * n, 0.017 * n);
+  }
+  ASSERT_THROW(s.merge(alg::KLL<int>(100)), std::runtime_error);
+}
+
+TEST(kll, serialize_round_trip) {
+  alg::KLL<double> s(100, 3);
+  for (int i = 0; i < 100000; i++) {
+    s.add(std::sqrt(static_cast<double>(i)));
+  }
+  std::vector<uint8_t> bytes = s.serialize();
+  alg::KLL<double> t = alg::KLL<double>::deserialize(bytes);
+  ASSERT_EQ(t.count(), s.count());
+  ASSERT_EQ(t.size(), s.size());
+  ASSERT_EQ(t.min(), s.min());
+  ASSERT_EQ(t.max(), s.max());
+  for (double const q : {0.1, 0.5, 0.9}) {
+    ASSERT_EQ(t.quantile(q), s.quantile(q));
+  }
+  bytes.pop_back();
+  ASSERT_THROW(alg::KLL<double>::deserialize(bytes), std::runtime_error);
+  bytes[0] ^= 1;
+  ASSERT_THROW(alg::KLL<double>::deserialize(bytes), std::runtime_error);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
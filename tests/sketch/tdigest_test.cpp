@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <random/prng.hpp>
+#include <sketch/tdigest.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+// `x`'s rank in sorted `a`, as a fraction
+static double true_rank(std::vector<double> const& a, double const x) {
+  return static_cast<double>(std::lower_bound(a.begin(), a.end(), x) -
+                             a.begin()) /
+         static_cast<double>(a.size());
+}
+
+// exponential, heavy on the right like latencies
+static std::vector<double> latencies(size_t const n, uint64_t const seed) {
+  alg::Xoshiro256 g(seed);
+  std::vector<double> a(n);
+  for (auto& x : a) {
+    x = -std::log(1.0 - alg::unit(g));
+  }
+  return a;
+}
+
+TEST(tdigest, empty_and_invalid) {
+  alg::TDigest t;
+  ASSERT_TRUE(t.empty());
+  ASSERT_THROW(t.quantile(0.5), std::runtime_error);
+  ASSERT_THROW(t.cdf(0), std::runtime_error);
+  ASSERT_THROW(alg::TDigest(1), std::runtime_error);
+  ASSERT_THROW(t.add(std::nan("")), std::runtime_error);
+  ASSERT_THROW(t.add(1, -1), std::runtime_error);
+  t.add(2);
+  ASSERT_EQ(t.quantile(0.5), 2);
+  ASSERT_THROW(t.quantile(-0.1), std::runtime_error);
+}
+
+TEST(tdigest, quantiles_of_latencies) {
+  size_t const n = 1000000;
+  std::vector<double> a = latencies(n, 5);
+  alg::TDigest t;
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  for (double const x : a) {
+    t.add(x);
+  }
+  timer.stop();
+  std::cout << "add: " << timer.miliseconds() << "ms, " << t.size()
+            << " centroids\n";
+  ASSERT_LE(t.size(), 200);
+  std::sort(a.begin(), a.end());
+  ASSERT_EQ(t.min(), a.front());
+  ASSERT_EQ(t.max(), a.back());
+  ASSERT_EQ(t.count(), n);
+
+  for (double const q : {0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+    double const error = std::abs(true_rank(a, t.quantile(q)) - q);
+    std::cout << "q = " << q << ": rank error " << error << "\n";
+    // 0.5% around the median, shrinking with `q (1 - q)` at the tails
+    double const bound = std::min(0.005, 0.5 * q * (1 - q));
+    ASSERT_LT(error, bound);
+    double const x = a[static_cast<size_t>(q * n)];
+    ASSERT_NEAR(t.cdf(x), q, bound);
+  }
+}
+
+TEST(tdigest, merge_and_serialize) {
+  size_t const n = 200000;
+  std::vector<double> a = latencies(n, 11);
+  alg::TDigest whole, left, right(200);
+  for (size_t i = 0; i < n; i++) {
+    whole.add(a[i]);
+    (i % 2 == 0 ? left : right).add(a[i]);
+  }
+  left.merge(right);
+  ASSERT_EQ(left.count(), n);
+  std::sort(a.begin(), a.end());
+  for (double const q : {0.01, 0.5, 0.99}) {
+    ASSERT_NEAR(true_rank(a, left.quantile(q)), q, 0.005);
+  }
+
+  std::vector<uint8_t> bytes = whole.serialize();
+  alg::TDigest const copy = alg::TDigest::deserialize(bytes);
+  ASSERT_EQ(copy.count(), whole.count());
+  ASSERT_EQ(copy.size(), whole.size());
+  for (double const q : {0.01, 0.5, 0.99}) {
+    ASSERT_EQ(copy.quantile(q), whole.quantile(q));
+  }
+  bytes.push_back(0);
+  ASSERT_THROW(alg::TDigest::deserialize(bytes), std::runtime_error);
+}
+
+TEST(tdigest, corrupt_serialized) {
+  for (double const d : {std::nan(""), HUGE_VAL, 1e300, -5.0}) {
+    ASSERT_THROW(alg::TDigest{d}, std::runtime_error);
+  }
+  alg::TDigest t;
+  for (int i = 0; i < 1000; i++) {
+    t.add(i);
+  }
+  std::vector<uint8_t> const bytes = t.serialize();
+  ASSERT_EQ(alg::TDigest::deserialize(bytes).count(), 1000);
+  ASSERT_TRUE(alg::TDigest::deserialize(alg::TDigest().serialize()).empty());
+
+  // tag, compression, count, min, max, centroid count, then the centroids
+  auto const corrupt = [&](size_t const offset, double const x) {
+    std::vector<uint8_t> b = bytes;
+    std::memcpy(b.data() + offset, &x, sizeof(x));
+    return b;
+  };
+  size_t const first_mean = 4 + 4 * 8 + 8;
+  ASSERT_THROW(alg::TDigest::deserialize(corrupt(4, std::nan(""))),
+               std::runtime_error);
+  ASSERT_THROW(alg::TDigest::deserialize(corrupt(4, 1e300)),
+               std::runtime_error);
+  // count not the sum of the weights
+  ASSERT_THROW(alg::TDigest::deserialize(corrupt(12, 999)),
+               std::runtime_error);
+  // first centroid after the second one
+  ASSERT_THROW(alg::TDigest::deserialize(corrupt(first_mean, 500)),
+               std::runtime_error);
+  // weight of the first centroid
+  ASSERT_THROW(alg::TDigest::deserialize(corrupt(first_mean + 8, -1)),
+               std::runtime_error);
+  ASSERT_THROW(alg::TDigest::deserialize(corrupt(first_mean + 8, 1e300)),
+               std::runtime_error);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,162 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <random/prng.hpp>
+#include <sort/columnar.hpp>
+#include <sort/merge.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+using alg::Columnar;
+using alg::SortDirection;
+using alg::SortKey;
+
+// a table as parallel columns: two keys and a payload
+struct Table {
+  std::vector<int32_t> region;
+  std::vector<double> price;
+  std::vector<uint64_t> id;
+  std::vector<std::string> name;
+};
+
+// the same table zipped into rows
+struct Row {
+  int32_t region;
+  double price;
+  uint64_t id;
+  std::string name;
+};
+
+// region ascending, then price descending
+static bool row_less(Row const& x, Row const& y) {
+  if (x.region != y.region) {
+    return x.region < y.region;
+  }
+  return x.price > y.price;
+}
+
+static Table random_table(size_t const n, uint64_t const seed) {
+  alg::Xoshiro256 g(seed);
+  Table t;
+  for (size_t i = 0; i < n; i++) {
+    t.region.push_back(static_cast<int32_t>(alg::bounded(g, 20)) - 10);
+    t.price.push_back(static_cast<double>(alg::bounded(g, 1000)) / 8 - 50);
+    t.id.push_back(i);
+    t.name.push_back("item" + std::to_string(alg::bounded(g, 100)));
+  }
+  return t;
+}
+
+static std::vector<Row> rows_of(Table const& t) {
+  std::vector<Row> rows;
+  for (size_t i = 0; i < t.id.size(); i++) {
+    rows.push_back({t.region[i], t.price[i], t.id[i], t.name[i]});
+  }
+  return rows;
+}
+
+TEST(columnar, single_column_directions) {
+  std::vector<int> const a = {5, -1, 3, 5, 0, -7, 3};
+  auto const up = Columnar::argsort(SortKey(a));
+  ASSERT_EQ(Columnar::gather(a, up), std::vector<int>({-7, -1, 0, 3, 3, 5, 5}));
+  // equal keys in their first order
+  ASSERT_EQ(up, std::vector<size_t>({5, 1, 4, 2, 6, 0, 3}));
+
+  auto const down =
+      Columnar::argsort(SortKey(a, SortDirection::Descending));
+  ASSERT_EQ(down, std::vector<size_t>({0, 3, 2, 6, 4, 1, 5}));
+
+  float const inf = std::numeric_limits<float>::infinity();
+  std::vector<float> const f = {0.5f, -inf, 2.0f, -0.25f, inf};
+  ASSERT_EQ(Columnar::gather(f, Columnar::argsort(SortKey(f))),
+            std::vector<float>({-inf, -0.25f, 0.5f, 2.0f, inf}));
+
+  ASSERT_TRUE(Columnar::argsort(SortKey(std::vector<int>{})).empty());
+  ASSERT_EQ(Columnar::argsort(SortKey(std::vector<int>{4})),
+            std::vector<size_t>({0}));
+}
+
+TEST(columnar, keys_of_different_sizes) {
+  std::vector<int> const a = {1, 2, 3};
+  std::vector<uint8_t> const b = {1, 2};
+  ASSERT_THROW(Columnar::argsort(SortKey(a), SortKey(b)), std::runtime_error);
+  ASSERT_THROW(Columnar::gather(b, Columnar::argsort(SortKey(a))),
+               std::runtime_error);
+}
+
+TEST(columnar, multiple_keys_like_rows) {
+  Table t = random_table(5000, 1);
+  std::vector<Row> rows = rows_of(t);
+  alg::Merge<Row, row_less>::sort(rows);
+
+  auto const p =
+      Columnar::argsort(SortKey(t.region),
+                        SortKey(t.price, SortDirection::Descending));
+  Columnar::apply(p, t.region, t.price, t.id, t.name);
+  for (size_t i = 0; i < rows.size(); i++) {
+    ASSERT_EQ(t.region[i], rows[i].region);
+    ASSERT_EQ(t.price[i], rows[i].price);
+    // stable: the same ids on ties as the stable merge sort
+    ASSERT_EQ(t.id[i], rows[i].id);
+    ASSERT_EQ(t.name[i], rows[i].name);
+  }
+}
+
+TEST(columnar, signed_zeros_are_ties) {
+  std::vector<double> const zeros = {0.0, -0.0, 0.0, -0.0};
+  ASSERT_EQ(Columnar::argsort(SortKey(zeros)),
+            std::vector<size_t>({0, 1, 2, 3}));
+  ASSERT_EQ(Columnar::argsort(SortKey(zeros, SortDirection::Descending)),
+            std::vector<size_t>({0, 1, 2, 3}));
+
+  // the same order as the stable merge sort of zipped rows
+  Table t;
+  t.region = {1, 0, 1, 0, 1, 0};
+  t.price = {-0.0, 0.0, 0.0, -0.0, 2.5, -0.0};
+  t.id = {0, 1, 2, 3, 4, 5};
+  t.name = {"a", "b", "c", "d", "e", "f"};
+  std::vector<Row> rows = rows_of(t);
+  alg::Merge<Row, row_less>::sort(rows);
+  auto const p =
+      Columnar::argsort(SortKey(t.region),
+                        SortKey(t.price, SortDirection::Descending));
+  for (size_t i = 0; i < rows.size(); i++) {
+    ASSERT_EQ(p[i], rows[i].id);
+  }
+}
+
+TEST(columnar, against_zipped_rows) {
+  size_t const n = 1 << 20;
+  Table const input = random_table(n, 2);
+  alg::Timer<HightResolutionClock> timer;
+
+  timer.start();
+  std::vector<Row> rows = rows_of(input);
+  alg::Merge<Row, row_less>::sort(rows);
+  timer.stop();
+  std::cout << "zipped rows + merge sort: " << timer.miliseconds() << "ms";
+
+  Table t = input;
+  timer.reset();
+  timer.start();
+  auto const p =
+      Columnar::argsort(SortKey(t.region),
+                        SortKey(t.price, SortDirection::Descending));
+  Columnar::apply(p, t.region, t.price, t.id, t.name);
+  timer.stop();
+  std::cout << ", columnar: " << timer.miliseconds() << "ms\n";
+
+  for (size_t i = 0; i < n; i++) {
+    ASSERT_EQ(t.id[i], rows[i].id);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
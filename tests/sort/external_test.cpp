@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <random/random.hpp>
+#include <sort/external.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+template <typename T>
+static void write_file(std::string const& path, std::vector<T> const& a) {
+  FILE* f = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(f, nullptr);
+  // `data()` of an empty vector may be null, which `fwrite` does not take
+  if (!a.empty()) {
+    ASSERT_EQ(std::fwrite(a.data(), sizeof(T), a.size(), f), a.size());
+  }
+  std::fclose(f);
+}
+
+template <typename T>
+static std::vector<T> read_file(std::string const& path) {
+  std::vector<T> a;
+  FILE* f = std::fopen(path.c_str(), "rb");
+  if (f == nullptr) {
+    return a;
+  }
+  T t;
+  while (std::fread(&t, sizeof(T), 1, f) == 1) {
+    a.push_back(t);
+  }
+  std::fclose(f);
+  return a;
+}
+
+static std::string temp_path(std::string const& name) {
+  return testing::TempDir() + "/alg_external_test_" + name;
+}
+
+static std::vector<uint64_t> random_keys(size_t const n) {
+  std::vector<uint64_t> a(n);
+  alg::RandIntGen<uint64_t> gen(0, UINT64_MAX);
+  for (auto& x : a) {
+    x = gen.gen();
+  }
+  return a;
+}
+
+TEST(external, input_fitting_in_memory) {
+  std::string const in = temp_path("small_in"), out = temp_path("small_out");
+  std::vector<uint64_t> input = random_keys(1000);
+  write_file(in, input);
+
+  alg::External<uint64_t>::sort(in, out);
+
+  std::sort(input.begin(), input.end());
+  ASSERT_EQ(read_file<uint64_t>(out), input);
+  std::remove(in.c_str());
+  std::remove(out.c_str());
+}
+
+TEST(external, multiple_merge_passes) {
+  std::string const in = temp_path("large_in"), out = temp_path("large_out");
+  std::vector<uint64_t> input = random_keys(1 << 20);
+  write_file(in, input);
+
+  // 64 KB of memory: 128 runs, merged 4 at a time in 4 passes
+  alg::ExternalOptions opt;
+  opt.memory = 1 << 16;
+  opt.fan_in = 4;
+  opt.temp_dir = testing::TempDir();
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::External<uint64_t>::sort(in, out, opt);
+  timer.stop();
+  std::cout << "elapsed time: " << timer.miliseconds() << "ms\n";
+
+  std::sort(input.begin(), input.end());
+  ASSERT_EQ(read_file<uint64_t>(out), input);
+  std::remove(in.c_str());
+  std::remove(out.c_str());
+}
+
+// fixed-width record with a key and a payload
+struct Record {
+  uint32_t key;
+  char payload[12];
+};
+
+static bool greater_key(Record const& r1, Record const& r2) {
+  return r1.key > r2.key;
+}
+
+TEST(external, records_in_place_with_user_defined_order) {
+  std::string const path = temp_path("records");
+  std::vector<Record> input(50000);
+  alg::RandIntGen<uint32_t> gen(0, 1000);
+  for (auto& r : input) {
+    r.key = gen.gen();
+    std::snprintf(r.payload, sizeof(r.payload), "%u", r.key * 7);
+  }
+  write_file(path, input);
+
+  alg::ExternalOptions opt;
+  opt.memory = 1 << 14;
+  opt.temp_dir = testing::TempDir();
+  alg::External<Record, greater_key>::sort(path, path, opt);
+
+  auto const output = read_file<Record>(path);
+  ASSERT_EQ(output.size(), input.size());
+  ASSERT_TRUE(std::is_sorted(output.begin(), output.end(), greater_key));
+  for (auto const& r : output) {
+    ASSERT_EQ(std::to_string(r.key * 7), r.payload);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(external, empty_input) {
+  std::string const in = temp_path("empty_in"), out = temp_path("empty_out");
+  write_file<uint64_t>(in, {});
+
+  alg::External<uint64_t>::sort(in, out);
+
+  ASSERT_TRUE(read_file<uint64_t>(out).empty());
+  std::remove(in.c_str());
+  std::remove(out.c_str());
+}
+
+TEST(external, invalid_input) {
+  std::string const in = temp_path("odd_in"), out = temp_path("odd_out");
+  write_file<uint8_t>(in, {1, 2, 3});
+
+  ASSERT_THROW(alg::External<uint64_t>::sort(in, out), std::runtime_error);
+  ASSERT_THROW(alg::External<uint64_t>::sort(temp_path("missing"), out),
+               std::runtime_error);
+  alg::ExternalOptions opt;
+  opt.fan_in = 1;
+  ASSERT_THROW(alg::External<uint32_t>::sort(in, out, opt),
+               std::runtime_error);
+  std::remove(in.c_str());
+  std::remove(out.c_str());
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
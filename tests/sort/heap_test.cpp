@@ -1,6 +1,12 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -252,6 +258,438 @@ TEST(heap_sort_user_defined_order, input_with_int_vec) {
   }
 }
 
+TEST(heap_sort, sub_range) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {6, 4, 7, 7, 8, 9, 10, 10, 8, 9, 10};
+
+  alg::Heap<int>::sort(input, 2, 7);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(pq, push_with_function_object_order) {
+  std::vector<int> data = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  PriorityQueue<int, std::greater<int>{}> pq(data);
+  std::sort(data.begin(), data.end(), std::greater<int>{});
+  for (int const x : data) {
+    ASSERT_EQ(pq.pop(), x);
+  }
+}
+
+TEST(pq, top_and_replace) {
+  PriorityQueue<int> pq(std::vector<int>({5, 3, 8}));
+  ASSERT_EQ(pq.top(), 3);
+  ASSERT_EQ(pq.replace(9), 3);
+  ASSERT_EQ(pq.top(), 5);
+  ASSERT_EQ(pq.size(), 3);
+  PriorityQueue<int> empty;
+  ASSERT_THROW(empty.top(), std::runtime_error);
+}
+
+TEST(top_k, stream_of_random_ints) {
+  int const n = 1 << 20, k = 100;
+  alg::RandIntGen<int> gen(0, 1 << 30);
+  std::vector<int> input(n);
+  for (auto& x : input) {
+    x = gen.gen();
+  }
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::TopK<int> top(k);
+  for (int const x : input) {
+    top.push(x);
+  }
+  auto const output = top.items();
+  timer.stop();
+  std::cout << "elapsed time: " << timer.miliseconds() << "ms\n";
+
+  std::sort(input.begin(), input.end(), std::greater<int>{});
+  input.resize(k);
+  ASSERT_EQ(output, input);
+  ASSERT_EQ(top.threshold(), input.back());
+}
+
+TEST(top_k, smallest_with_greater_order) {
+  alg::TopK<int, Order<int>::greater> bottom(3);
+  for (int const x : {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10}) {
+    bottom.push(x);
+  }
+  ASSERT_EQ(bottom.items(), std::vector<int>({4, 6, 7}));
+
+  alg::TopK<int> none(0);
+  none.push(1);
+  ASSERT_EQ(none.size(), 0);
+}
+
+TEST(dary_heap, push_and_pop_against_priority_queue) {
+  int const n = 1 << 20;
+  alg::RandIntGen<int> gen(0, 1 << 30);
+  std::vector<int> input(n);
+  for (auto& x : input) {
+    x = gen.gen();
+  }
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  PriorityQueue<int> pq;
+  for (int const x : input) {
+    pq.push(x);
+  }
+  std::vector<int> binary(n);
+  for (auto& x : binary) {
+    x = pq.pop();
+  }
+  timer.stop();
+  std::cout << "PriorityQueue, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  timer.reset();
+  timer.start();
+  alg::DaryHeap<int> heap;
+  for (int const x : input) {
+    heap.push(x);
+  }
+  std::vector<int> dary(n);
+  for (auto& x : dary) {
+    x = heap.pop();
+  }
+  timer.stop();
+  std::cout << "DaryHeap, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  std::sort(input.begin(), input.end());
+  ASSERT_EQ(binary, input);
+  ASSERT_EQ(dary, input);
+  ASSERT_THROW(heap.pop(), std::runtime_error);
+}
+
+static bool less_pointee(std::unique_ptr<int> const& t1,
+                         std::unique_ptr<int> const& t2) {
+  return *t1 < *t2;
+}
+
+TEST(dary_heap, move_only_items_and_heapify) {
+  alg::DaryHeap<std::unique_ptr<int>, less_pointee, 3> heap;
+  for (int const x : {6, 4, 10, 9, 7, 7, 8}) {
+    heap.push(std::make_unique<int>(x));
+  }
+  heap.emplace(new int(1));
+  std::vector<int> output;
+  while (!heap.empty()) {
+    output.push_back(*heap.pop());
+  }
+  ASSERT_EQ(output, std::vector<int>({1, 4, 6, 7, 7, 8, 9, 10}));
+
+  alg::DaryHeap<int, std::greater<int>{}> max_heap(
+      std::vector<int>({6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10}));
+  ASSERT_EQ(max_heap.size(), 11);
+  ASSERT_EQ(max_heap.top(), 10);
+  ASSERT_EQ(max_heap.pop(), 10);
+  ASSERT_EQ(max_heap.pop(), 10);
+  ASSERT_EQ(max_heap.pop(), 10);
+  ASSERT_EQ(max_heap.pop(), 9);
+}
+
+TEST(index_min_pq, change_keys_in_place) {
+  alg::IndexMinPQ<double> pq(5);
+  pq.push(0, 3.5);
+  pq.push(3, 1.5);
+  pq.push(4, 2.5);
+  ASSERT_TRUE(pq.contains(3));
+  ASSERT_FALSE(pq.contains(1));
+  ASSERT_EQ(pq.top(), 3);
+
+  pq.decrease_key(4, 0.5);
+  ASSERT_EQ(pq.top(), 4);
+  ASSERT_EQ(pq.top_key(), 0.5);
+  pq.increase_key(4, 9.5);
+  pq.change_key(0, 1.0);
+  ASSERT_EQ(pq.key(0), 1.0);
+  ASSERT_EQ(pq.pop(), 0);
+  ASSERT_EQ(pq.pop(), 3);
+  pq.erase(4);
+  ASSERT_TRUE(pq.empty());
+
+  ASSERT_THROW(pq.push(5, 1.0), std::runtime_error);
+  ASSERT_THROW(pq.key(2), std::runtime_error);
+  pq.push(2, 1.0);
+  ASSERT_THROW(pq.push(2, 1.0), std::runtime_error);
+  ASSERT_THROW(pq.decrease_key(2, 2.0), std::runtime_error);
+  ASSERT_THROW(pq.increase_key(2, 0.0), std::runtime_error);
+}
+
+TEST(index_min_pq, random_operations_against_brute_force) {
+  size_t const n = 1000;
+  alg::IndexMinPQ<int> pq(n);
+  std::vector<int> keys(n);
+  std::vector<bool> queued(n, false);
+  alg::RandIntGen<int> gen(0, 1 << 20);
+  for (int step = 0; step < 100000; step++) {
+    size_t const i = gen.gen() % n;
+    int const key = gen.gen();
+    switch (gen.gen() % 4) {
+      case 0:
+        if (!queued[i]) {
+          pq.push(i, key);
+          queued[i] = true;
+          keys[i] = key;
+        }
+        break;
+      case 1:
+        if (queued[i]) {
+          pq.change_key(i, key);
+          keys[i] = key;
+        }
+        break;
+      case 2:
+        if (queued[i]) {
+          pq.erase(i);
+          queued[i] = false;
+        }
+        break;
+      default:
+        if (!pq.empty()) {
+          size_t const top = pq.pop();
+          ASSERT_TRUE(queued[top]);
+          for (size_t j = 0; j < n; j++) {
+            ASSERT_TRUE(!queued[j] || keys[top] <= keys[j]);
+          }
+          queued[top] = false;
+        }
+    }
+    ASSERT_EQ(pq.contains(i), queued[i]);
+  }
+}
+
+TEST(pairing_heap, push_and_pop_against_priority_queue) {
+  std::vector<int> input(1 << 16);
+  alg::RandIntGen<int> gen(0, 1000);
+  for (auto& x : input) {
+    x = gen.gen();
+  }
+  PriorityQueue<int> pq;
+  alg::PairingHeap<int> heap;
+  for (int const x : input) {
+    pq.push(x);
+    heap.push(x);
+    ASSERT_EQ(heap.top(), pq.top());
+  }
+  // interleave pops with pushes
+  for (size_t i = 0; i < input.size() / 2; i++) {
+    ASSERT_EQ(heap.pop(), pq.pop());
+    heap.push(input[i]);
+    pq.push(input[i]);
+  }
+  ASSERT_EQ(heap.size(), pq.size());
+  while (!heap.empty()) {
+    ASSERT_EQ(heap.pop(), pq.pop());
+  }
+  ASSERT_THROW(heap.pop(), std::runtime_error);
+  ASSERT_THROW(heap.top(), std::runtime_error);
+}
+
+TEST(pairing_heap, meld_and_decrease_key) {
+  alg::PairingHeap<int> h1, h2;
+  std::vector<alg::PairingHeap<int>::Handle> handles;
+  for (int const x : {60, 40, 100, 90}) {
+    handles.push_back(h1.push(x));
+  }
+  for (int const x : {70, 75, 80, 20}) {
+    handles.push_back(h2.push(x));
+  }
+  h1.meld(h2);
+  ASSERT_TRUE(h2.empty());
+  ASSERT_EQ(h1.size(), 8);
+  ASSERT_EQ(h1.top(), 20);
+
+  // handles of the melded heap stay valid
+  h1.decrease_key(handles[6], 10);
+  ASSERT_EQ(h1.key(handles[6]), 10);
+  h1.decrease_key(handles[2], 30);
+  ASSERT_THROW(h1.decrease_key(handles[3], 95), std::runtime_error);
+  ASSERT_EQ(h1.pop(), 10);
+  h1.decrease_key(handles[3], 5);
+  h1.decrease_key(handles[3], 5);
+
+  std::vector<int> output;
+  while (!h1.empty()) {
+    output.push_back(h1.pop());
+  }
+  ASSERT_EQ(output, std::vector<int>({5, 20, 30, 40, 60, 70, 75}));
+
+  // a heap left with items frees them
+  alg::PairingHeap<std::string, std::greater<std::string>{}> h3;
+  for (int i = 0; i < 100000; i++) {
+    h3.push(std::to_string(i));
+  }
+  h3.pop();
+  alg::PairingHeap<std::string, std::greater<std::string>{}> h4 =
+      std::move(h3);
+  ASSERT_EQ(h4.top(), "99998");
+}
+
+TEST(radix_heap, monotone_operations_against_multiset) {
+  alg::RandIntGen<int> gen(0, 1 << 12);
+  alg::RadixHeap<uint32_t> heap;
+  std::multiset<uint32_t> queued;
+  uint32_t last = 0;
+  for (int step = 0; step < 100000; step++) {
+    if (gen.gen() % 3 != 0 || heap.empty()) {
+      uint32_t const x = last + gen.gen() % (1 << (gen.gen() % 13));
+      heap.push(x);
+      queued.insert(x);
+    } else {
+      ASSERT_EQ(heap.top(), *queued.begin());
+      last = heap.pop();
+      ASSERT_EQ(last, *queued.begin());
+      queued.erase(queued.begin());
+    }
+    ASSERT_EQ(heap.size(), queued.size());
+  }
+  if (last > 0) {
+    ASSERT_THROW(heap.push(last - 1), std::runtime_error);
+  }
+  while (!heap.empty()) {
+    ASSERT_EQ(heap.pop(), *queued.begin());
+    queued.erase(queued.begin());
+  }
+  ASSERT_THROW(heap.pop(), std::runtime_error);
+}
+
+TEST(radix_heap, signed_and_floating_point_keys) {
+  alg::RadixHeap<int64_t> ints;
+  std::vector<int64_t> const input = {5, -3, 0, -1000000000000, 7, -3};
+  for (int64_t const x : input) {
+    ints.push(x);
+  }
+  ASSERT_EQ(ints.pop(), -1000000000000);
+  ASSERT_EQ(ints.pop(), -3);
+  ints.push(-2);
+  ASSERT_EQ(ints.pop(), -3);
+  ASSERT_EQ(ints.pop(), -2);
+  ASSERT_THROW(ints.push(-4), std::runtime_error);
+
+  auto key = [](std::pair<double, int> const& p) { return p.first; };
+  alg::RadixHeap<std::pair<double, int>, key> doubles;
+  doubles.push({2.5, 0});
+  doubles.push({-1.5, 1});
+  doubles.push({0.0, 2});
+  ASSERT_EQ(doubles.pop().second, 1);
+  doubles.push({-0.5, 3});
+  ASSERT_EQ(doubles.pop().second, 3);
+  ASSERT_EQ(doubles.pop().second, 2);
+  ASSERT_EQ(doubles.pop().second, 0);
+}
+
+// adjacency lists of a random digraph with small integer weights
+struct Arc {
+  size_t to;
+  uint32_t weight;
+};
+
+static std::vector<std::vector<Arc>> random_digraph(size_t const v,
+                                                    size_t const e) {
+  std::vector<std::vector<Arc>> adj(v);
+  alg::RandIntGen<size_t> vertex(0, v - 1);
+  alg::RandIntGen<uint32_t> weight(0, 100);
+  for (size_t i = 0; i < e; i++) {
+    adj[vertex.gen()].push_back(Arc{vertex.gen(), weight.gen()});
+  }
+  return adj;
+}
+
+static constexpr uint32_t UNREACHED = static_cast<uint32_t>(-1);
+
+using Label = std::pair<uint32_t, size_t>;
+
+// Dijkstra with a queue of (distance, vertex) labels, stale ones skipped
+template <typename Queue>
+static std::vector<uint32_t> lazy_dijkstra(
+    std::vector<std::vector<Arc>> const& adj) {
+  std::vector<uint32_t> dist(adj.size(), UNREACHED);
+  Queue pq;
+  dist[0] = 0;
+  pq.push(Label{0, 0});
+  while (pq.size() > 0) {
+    auto const [d, v] = pq.pop();
+    if (d != dist[v]) {
+      continue;
+    }
+    for (Arc const& a : adj[v]) {
+      if (d + a.weight < dist[a.to]) {
+        dist[a.to] = d + a.weight;
+        pq.push(Label{dist[a.to], a.to});
+      }
+    }
+  }
+  return dist;
+}
+
+// Dijkstra with a label per vertex, decreased in place
+static std::vector<uint32_t> pairing_dijkstra(
+    std::vector<std::vector<Arc>> const& adj) {
+  std::vector<uint32_t> dist(adj.size(), UNREACHED);
+  std::vector<alg::PairingHeap<Label>::Handle> handles(adj.size());
+  std::vector<bool> queued(adj.size(), false);
+  alg::PairingHeap<Label> pq;
+  dist[0] = 0;
+  handles[0] = pq.push(Label{0, 0});
+  queued[0] = true;
+  while (!pq.empty()) {
+    auto const [d, v] = pq.pop();
+    queued[v] = false;
+    for (Arc const& a : adj[v]) {
+      if (d + a.weight < dist[a.to]) {
+        dist[a.to] = d + a.weight;
+        if (queued[a.to]) {
+          pq.decrease_key(handles[a.to], Label{dist[a.to], a.to});
+        } else {
+          handles[a.to] = pq.push(Label{dist[a.to], a.to});
+          queued[a.to] = true;
+        }
+      }
+    }
+  }
+  return dist;
+}
+
+static uint32_t distance_of(Label const& l) {
+  return l.first;
+}
+
+TEST(radix_heap, shortest_paths_with_each_queue) {
+  auto const adj = random_digraph(1 << 16, 1 << 19);
+  alg::Timer<HightResolutionClock> timer;
+
+  timer.start();
+  auto const binary = lazy_dijkstra<PriorityQueue<Label>>(adj);
+  timer.stop();
+  std::cout << "PriorityQueue, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  timer.reset();
+  timer.start();
+  auto const dary = lazy_dijkstra<alg::DaryHeap<Label>>(adj);
+  timer.stop();
+  std::cout << "DaryHeap, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  timer.reset();
+  timer.start();
+  auto const pairing = pairing_dijkstra(adj);
+  timer.stop();
+  std::cout << "PairingHeap, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  timer.reset();
+  timer.start();
+  auto const radix = lazy_dijkstra<alg::RadixHeap<Label, distance_of>>(adj);
+  timer.stop();
+  std::cout << "RadixHeap, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  ASSERT_EQ(dary, binary);
+  ASSERT_EQ(pairing, binary);
+  ASSERT_EQ(radix, binary);
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <random/random.hpp>
+#include <sort/indirect.hpp>
+#include <sort/merge.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+// a large record, sorted by `key`, that counts its copies and moves
+struct Record {
+  static inline size_t copies = 0, moves = 0;
+
+  int key = 0;
+  size_t id = 0;
+  std::array<char, 240> payload{};
+
+  Record() = default;
+  Record(int const k, size_t const i) : key{k}, id{i} {}
+  Record(Record const& o) : key{o.key}, id{o.id}, payload{o.payload} {
+    copies++;
+  }
+  Record(Record&& o) noexcept : key{o.key}, id{o.id}, payload{o.payload} {
+    moves++;
+  }
+  Record& operator=(Record const& o) {
+    key = o.key;
+    id = o.id;
+    payload = o.payload;
+    copies++;
+    return *this;
+  }
+  Record& operator=(Record&& o) noexcept {
+    key = o.key;
+    id = o.id;
+    payload = o.payload;
+    moves++;
+    return *this;
+  }
+};
+
+static bool key_less(Record const& x, Record const& y) {
+  return x.key < y.key;
+}
+
+static uint64_t key_prefix(Record const& r) {
+  return alg::RadixBits<int>::encode(r.key);
+}
+
+static std::vector<Record> random_records(size_t const n, int const keys) {
+  alg::RandIntGen<int> gen(0, keys - 1);
+  std::vector<Record> a;
+  a.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    a.emplace_back(gen.gen(), i);
+  }
+  return a;
+}
+
+// sorted by key, and ids ascending among equal keys
+static bool stable_sorted(std::vector<Record> const& a) {
+  for (size_t i = 1; i < a.size(); i++) {
+    if (a[i].key < a[i - 1].key ||
+        (a[i].key == a[i - 1].key && a[i].id < a[i - 1].id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(indirect, argsort_and_apply) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  auto const p = alg::Indirect<int>::argsort(input);
+  ASSERT_EQ(p, std::vector<size_t>({1, 0, 4, 5, 6, 8, 3, 9, 2, 7, 10}));
+
+  alg::Indirect<int>::apply(input, p);
+  ASSERT_EQ(input,
+            std::vector<int>({4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10}));
+
+  std::vector<std::string> words = {"banana", "apple",       "applesauce",
+                                    "apple",  "cherry pie",  "",
+                                    "cherry", "cherry piee", "b"};
+  auto expect = words;
+  std::stable_sort(expect.begin(), expect.end());
+  alg::Indirect<std::string>::sort(words);
+  ASSERT_EQ(words, expect);
+
+  // descending: no built in prefix, every compare through `cmp`
+  std::vector<double> doubles = {1.5, -2.0, 3.25, 0.0, 3.25};
+  alg::Indirect<double, alg::Order<double>::greater>::sort(doubles);
+  ASSERT_EQ(doubles, std::vector<double>({3.25, 3.25, 1.5, 0.0, -2.0}));
+}
+
+TEST(indirect, signed_zeros_are_ties) {
+  // -0.0 == 0.0, so they keep their order
+  std::vector<double> const zeros = {0.0, -0.0, 0.0, -0.0};
+  ASSERT_EQ(alg::Indirect<double>::argsort(zeros),
+            std::vector<size_t>({0, 1, 2, 3}));
+  std::vector<float> const mixed = {1.0f, -0.0f, -1.0f, 0.0f, -0.0f};
+  ASSERT_EQ(alg::Indirect<float>::argsort(mixed),
+            std::vector<size_t>({2, 1, 3, 4, 0}));
+}
+
+TEST(indirect, records_moved_once) {
+  size_t const n = 1 << 16;
+  auto input = random_records(n, 1000);
+
+  auto merged = input;
+  Record::copies = Record::moves = 0;
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::Merge<Record, key_less>::sort(merged);
+  timer.stop();
+  std::cout << "Merge, elapsed time: " << timer.miliseconds() << "ms, "
+            << Record::copies << " copies, " << Record::moves << " moves\n";
+  ASSERT_EQ(Record::copies, 0);
+  ASSERT_TRUE(stable_sorted(merged));
+
+  auto indirect = input;
+  Record::copies = Record::moves = 0;
+  timer.reset();
+  timer.start();
+  alg::Indirect<Record, key_less, key_prefix>::sort(indirect);
+  timer.stop();
+  std::cout << "Indirect, elapsed time: " << timer.miliseconds() << "ms, "
+            << Record::copies << " copies, " << Record::moves << " moves\n";
+  ASSERT_EQ(Record::copies, 0);
+  // one move per item, plus one per cycle
+  ASSERT_LE(Record::moves, n + n / 2);
+  ASSERT_TRUE(stable_sorted(indirect));
+
+  auto unprefixed = input;
+  alg::Indirect<Record, key_less>::sort(unprefixed);
+  ASSERT_TRUE(stable_sorted(unprefixed));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
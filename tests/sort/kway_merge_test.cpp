@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <sort/heap.hpp>
+#include <sort/kway_merge.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+// `k` sorted runs of random sizes up to `max_len`
+static std::vector<std::vector<int>> sorted_runs(size_t const k,
+                                                 size_t const max_len,
+                                                 uint64_t const range,
+                                                 uint64_t const seed) {
+  alg::Xoshiro256 g(seed);
+  std::vector<std::vector<int>> runs(k);
+  for (auto& run : runs) {
+    run.resize(alg::bounded(g, max_len + 1));
+    for (auto& x : run) {
+      x = static_cast<int>(alg::bounded(g, range));
+    }
+    std::sort(run.begin(), run.end());
+  }
+  return runs;
+}
+
+static std::vector<int> concat_sorted(
+    std::vector<std::vector<int>> const& runs) {
+  std::vector<int> r;
+  for (auto const& run : runs) {
+    r.insert(r.end(), run.begin(), run.end());
+  }
+  std::stable_sort(r.begin(), r.end());
+  return r;
+}
+
+// item with the run it came from
+struct Tagged {
+  int key;
+  int run;
+
+  bool operator==(Tagged const&) const = default;
+};
+
+static bool key_less(Tagged const& x, Tagged const& y) {
+  return x.key < y.key;
+}
+
+TEST(kway_merge, small_and_empty_runs) {
+  using M = alg::KWayMerge<int>;
+  ASSERT_TRUE(M::merge(std::vector<std::vector<int>>{}).empty());
+  ASSERT_TRUE(M::merge({{}, {}, {}}).empty());
+  ASSERT_EQ(M::merge({{1, 4, 9}, {}, {2, 3, 10}, {0}, {5}}),
+            std::vector<int>({0, 1, 2, 3, 4, 5, 9, 10}));
+  ASSERT_EQ(M::merge({{3, 4, 5}}), std::vector<int>({3, 4, 5}));
+
+  std::vector<std::string> const words =
+      alg::KWayMerge<std::string, std::greater<std::string>{}>::merge(
+          {{"pear", "fig"}, {"plum", "kiwi", "apple"}});
+  ASSERT_EQ(words, std::vector<std::string>(
+                       {"plum", "pear", "kiwi", "fig", "apple"}));
+}
+
+TEST(kway_merge, any_fan_in) {
+  for (size_t k = 1; k <= 300; k += 13) {
+    auto const runs = sorted_runs(k, 100, 1000, k);
+    ASSERT_EQ(alg::KWayMerge<int>::merge(runs), concat_sorted(runs));
+  }
+}
+
+TEST(kway_merge, stable_across_runs) {
+  alg::Scheduler sched(4);
+  auto const keys = sorted_runs(100, 3000, 50, 1);
+  std::vector<std::vector<Tagged>> runs(keys.size());
+  std::vector<Tagged> expect;
+  for (size_t i = 0; i < keys.size(); i++) {
+    for (int const x : keys[i]) {
+      runs[i].push_back({x, static_cast<int>(i)});
+    }
+    expect.insert(expect.end(), runs[i].begin(), runs[i].end());
+  }
+  std::stable_sort(expect.begin(), expect.end(), key_less);
+  ASSERT_EQ((alg::KWayMerge<Tagged, key_less>::merge(runs)), expect);
+  ASSERT_EQ((alg::KWayMerge<Tagged, key_less>::merge(runs, sched)), expect);
+}
+
+TEST(kway_merge, select_cuts) {
+  auto const runs = sorted_runs(37, 500, 20, 2);
+  std::vector<std::span<int const>> spans;
+  size_t n = 0;
+  for (auto const& run : runs) {
+    spans.emplace_back(run);
+    n += run.size();
+  }
+  std::vector<int> const merged = concat_sorted(runs);
+  for (size_t r = 0; r <= n; r += 97) {
+    std::vector<size_t> const cut = alg::KWayMerge<int>::select(spans, r);
+    size_t sum = 0;
+    for (size_t i = 0; i < runs.size(); i++) {
+      sum += cut[i];
+      // nothing taken greater than the rank `r` item, nothing left less
+      if (cut[i] > 0 && r < n) {
+        ASSERT_LE(runs[i][cut[i] - 1], merged[r]);
+      }
+      if (cut[i] < runs[i].size() && r > 0) {
+        ASSERT_GE(runs[i][cut[i]], merged[r - 1]);
+      }
+    }
+    ASSERT_EQ(sum, r);
+  }
+}
+
+TEST(kway_merge, parallel_against_heap) {
+  size_t const k = 256;
+  auto const runs = sorted_runs(k, 8192, 1 << 30, 3);
+  std::vector<int> const expect = concat_sorted(runs);
+  alg::Timer<HightResolutionClock> timer;
+
+  timer.start();
+  std::vector<int> const a = alg::KWayMerge<int>::merge(runs);
+  timer.stop();
+  ASSERT_EQ(a, expect);
+  std::cout << "loser tree: " << timer.miliseconds() << "ms";
+
+  for (size_t const threads : {2, 4}) {
+    alg::Scheduler sched(threads);
+    timer.reset();
+    timer.start();
+    std::vector<int> const b = alg::KWayMerge<int>::merge(runs, sched);
+    timer.stop();
+    ASSERT_EQ(b, expect);
+    std::cout << ", " << threads << " threads " << timer.miliseconds()
+              << "ms";
+  }
+
+  // heads of the runs in a binary heap, least key on top
+  using Head = std::pair<int, size_t>;
+  timer.reset();
+  timer.start();
+  alg::PriorityQueue<Head> pq;
+  std::vector<size_t> next(k, 1);
+  for (size_t i = 0; i < k; i++) {
+    if (!runs[i].empty()) {
+      pq.push({runs[i][0], i});
+    }
+  }
+  std::vector<int> c;
+  c.reserve(expect.size());
+  while (pq.size() > 0) {
+    auto const [x, i] = pq.top();
+    c.push_back(x);
+    if (next[i] < runs[i].size()) {
+      pq.replace({runs[i][next[i]++], i});
+    } else {
+      pq.pop();
+    }
+  }
+  timer.stop();
+  ASSERT_EQ(c, expect);
+  std::cout << ", binary heap " << timer.miliseconds() << "ms\n";
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
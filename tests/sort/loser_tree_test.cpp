@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <random/random.hpp>
+#include <sort/loser_tree.hpp>
+
+#include <gtest/gtest.h>
+
+// merge sorted `runs` through a loser tree
+template <typename T, auto cmp = alg::Order<T>::less>
+static std::vector<T> merge(std::vector<std::vector<T>> const& runs) {
+  alg::LoserTree<T, cmp> tree(runs.size());
+  std::vector<size_t> next(runs.size(), 0);
+  for (size_t i = 0; i < runs.size(); i++) {
+    if (!runs[i].empty()) {
+      tree.set(i, runs[i][next[i]++]);
+    }
+  }
+  tree.build();
+  std::vector<T> output;
+  while (!tree.empty()) {
+    size_t const s = tree.top();
+    output.push_back(tree.min());
+    if (next[s] < runs[s].size()) {
+      tree.replace(runs[s][next[s]++]);
+    } else {
+      tree.pop();
+    }
+  }
+  return output;
+}
+
+TEST(loser_tree, merge_small_runs) {
+  std::vector<std::vector<int>> runs = {{1, 4, 9}, {}, {2, 3, 10}, {0}, {5}};
+  std::vector<int> expect = {0, 1, 2, 3, 4, 5, 9, 10};
+
+  ASSERT_EQ(merge(runs), expect);
+}
+
+TEST(loser_tree, single_and_empty_sources) {
+  ASSERT_EQ(merge<int>({{3, 4, 5}}), std::vector<int>({3, 4, 5}));
+  ASSERT_TRUE(merge<int>({{}, {}, {}}).empty());
+}
+
+TEST(loser_tree, merge_random_runs_of_any_fan_in) {
+  alg::RandIntGen<int> gen(0, 1000);
+  for (size_t k = 1; k <= 33; k++) {
+    std::vector<std::vector<int>> runs(k);
+    std::vector<int> expect;
+    for (auto& run : runs) {
+      run.resize(gen.gen() % 50);
+      for (auto& x : run) {
+        x = gen.gen();
+      }
+      std::sort(run.begin(), run.end(), std::greater<int>{});
+      expect.insert(expect.end(), run.begin(), run.end());
+    }
+    std::sort(expect.begin(), expect.end(), std::greater<int>{});
+
+    ASSERT_EQ((merge<int, std::greater<int>{}>(runs)), expect) << "k = " << k;
+  }
+}
+
+TEST(loser_tree, ties_go_to_the_lower_source) {
+  using Record = std::pair<int, int>;
+  auto const by_key = [](Record const& r1, Record const& r2) {
+    return r1.first < r2.first;
+  };
+  std::vector<std::vector<Record>> runs = {
+      {{1, 0}, {2, 0}, {2, 1}}, {{1, 2}, {2, 3}}, {{0, 4}, {2, 5}}};
+
+  auto const output = merge<Record, by_key>(runs);
+
+  ASSERT_TRUE(std::is_sorted(output.begin(), output.end()));
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <random/random.hpp>
 #include <sort/merge.hpp>
+#include <string>
 #include <time/timer.hpp>
+#include <utility>
 #include <vector>
 
 TEST(plain_order, input_with_int_vec) {
@@ -337,6 +341,166 @@ TEST(user_defined_order, input_with_int_vec_bottom_up_version) {
   }
 }
 
+using Record = std::pair<int, int>;
+
+static bool less_by_key(Record const& t1, Record const& t2) {
+  return t1.first < t2.first;
+}
+
+TEST(parallel, input_with_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10};
+
+  alg::ParallelMerge<int>::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(parallel, stable_with_random_vec) {
+  int const n = 1 << 20;
+  std::vector<Record> input(n);
+  alg::RandIntGen<int> gen(0, 1000);
+  for (int i = 0; i < n; i++) {
+    input[i] = {gen.gen(), i};
+  }
+  std::vector<Record> expect = input;
+  std::stable_sort(expect.begin(), expect.end(), less_by_key);
+  std::vector<Record> serial = input;
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::Merge<Record, less_by_key>::sort(serial);
+  timer.stop();
+  double const serial_ms = timer.miliseconds();
+
+  alg::Scheduler sched(8);
+  timer.reset();
+  timer.start();
+  alg::ParallelMerge<Record, less_by_key>::sort(input, sched);
+  timer.stop();
+  double const parallel_ms = timer.miliseconds();
+
+  std::cout << "Merge: " << serial_ms << "ms, ParallelMerge with "
+            << sched.concurrency() << " threads: " << parallel_ms
+            << "ms, speedup: " << serial_ms / parallel_ms << '\n';
+
+  ASSERT_EQ(serial, expect);
+  ASSERT_EQ(input, expect);
+}
+
+static bool less_pointee(std::unique_ptr<int> const& t1,
+                         std::unique_ptr<int> const& t2) {
+  return *t1 < *t2;
+}
+
+TEST(move_only, input_with_unique_ptr_vec) {
+  int const n = 1 << 15;
+  alg::RandIntGen<int> gen(0, 1000);
+  std::vector<int> expect(n);
+  std::vector<std::unique_ptr<int>> a, b, c;
+  for (int i = 0; i < n; i++) {
+    expect[i] = gen.gen();
+    a.push_back(std::make_unique<int>(expect[i]));
+    b.push_back(std::make_unique<int>(expect[i]));
+    c.push_back(std::make_unique<int>(expect[i]));
+  }
+  std::sort(expect.begin(), expect.end());
+
+  alg::Merge<std::unique_ptr<int>, less_pointee>::sort(a);
+  alg::MergeBU<std::unique_ptr<int>, less_pointee>::sort(b);
+  alg::Scheduler sched(4);
+  alg::ParallelMerge<std::unique_ptr<int>, less_pointee>::sort(c, sched);
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(*a[i], expect[i]);
+    ASSERT_EQ(*b[i], expect[i]);
+    ASSERT_EQ(*c[i], expect[i]);
+  }
+}
+
+TEST(scratch, reused_across_sorts) {
+  std::vector<std::string> scratch;
+  alg::RandIntGen<int> gen(0, 1 << 20);
+  for (size_t n : {100, 5000, 20, 0, 3000}) {
+    std::vector<std::string> input(n);
+    for (auto& s : input) {
+      s = std::to_string(gen.gen());
+    }
+    std::vector<std::string> expect = input;
+    std::sort(expect.begin(), expect.end());
+    std::vector<std::string> bottom_up = input;
+
+    alg::Merge<std::string>::sort(input, scratch);
+    ASSERT_GE(scratch.size(), n);
+    alg::MergeBU<std::string>::sort(bottom_up, scratch);
+
+    ASSERT_EQ(input, expect);
+    ASSERT_EQ(bottom_up, expect);
+  }
+  ASSERT_EQ(scratch.size(), 5000);
+}
+
+TEST(natural, input_with_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10};
+
+  alg::NaturalMerge<int>::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(natural, stable_with_patterns) {
+  int const n = 1 << 16;
+  alg::RandIntGen<int> gen(0, n);
+  std::vector<std::vector<Record>> inputs(5, std::vector<Record>(n));
+  for (int i = 0; i < n; i++) {
+    // random, few keys, descending runs, sawtooth, two interleaved halves
+    inputs[0][i] = {gen.gen(), i};
+    inputs[1][i] = {gen.gen() % 4, i};
+    inputs[2][i] = {(n - i) / 3, i};
+    inputs[3][i] = {i % 1000, i};
+    inputs[4][i] = {i < n / 2 ? 2 * i : 2 * (i - n / 2) + 1, i};
+  }
+  for (auto& input : inputs) {
+    std::vector<Record> expect = input;
+    std::stable_sort(expect.begin(), expect.end(), less_by_key);
+
+    alg::NaturalMerge<Record, less_by_key>::sort(input);
+
+    ASSERT_EQ(input, expect);
+  }
+}
+
+TEST(natural, nearly_sorted_against_merge) {
+  int const n = 1 << 22;
+  std::vector<int> input(n);
+  for (int i = 0; i < n; i++) {
+    input[i] = i;
+  }
+  alg::RandIntGen<int> gen(0, n - 1);
+  for (int i = 0; i < 100; i++) {
+    std::swap(input[gen.gen()], input[gen.gen()]);
+  }
+  std::vector<int> expect = input;
+  std::sort(expect.begin(), expect.end());
+  std::vector<int> natural = input;
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::Merge<int>::sort(input);
+  timer.stop();
+  std::cout << "Merge, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  timer.reset();
+  timer.start();
+  alg::NaturalMerge<int>::sort(natural);
+  timer.stop();
+  std::cout << "NaturalMerge, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  ASSERT_EQ(input, expect);
+  ASSERT_EQ(natural, expect);
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
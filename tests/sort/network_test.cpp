@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <random/random.hpp>
+#include <sort/insertion.hpp>
+#include <sort/network.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// every length up to `MAX`, at an offset inside a larger array
+template <typename T>
+static void expect_sorted_like_std(T const lo, T const hi) {
+  alg::RandIntGen<int64_t> gen(static_cast<int64_t>(lo),
+                               static_cast<int64_t>(hi));
+  for (size_t n = 0; n <= alg::Network<T>::MAX; n++) {
+    std::vector<T> input(n + 2);
+    for (auto& x : input) {
+      x = static_cast<T>(gen.gen());
+    }
+    std::vector<T> expect = input;
+    std::sort(expect.begin() + 1, expect.end() - 1);
+
+    alg::Network<T>::sort(input.data() + 1, n);
+
+    ASSERT_EQ(input, expect) << "n = " << n;
+  }
+}
+
+TEST(network, input_with_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10};
+
+  alg::Network<int>::sort(input, 0, input.size() - 1);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(network, input_with_every_length_and_type) {
+  expect_sorted_like_std<int8_t>(-128, 127);
+  expect_sorted_like_std<uint8_t>(0, 255);
+  expect_sorted_like_std<int16_t>(-32768, 32767);
+  expect_sorted_like_std<uint16_t>(0, 65535);
+  expect_sorted_like_std<int32_t>(-1000000, 1000000);
+  expect_sorted_like_std<uint32_t>(0, 1000000);
+  expect_sorted_like_std<int64_t>(-1000000000000, 1000000000000);
+  expect_sorted_like_std<uint64_t>(0, 1000000000000);
+  expect_sorted_like_std<float>(-1000, 1000);
+  expect_sorted_like_std<double>(-1000, 1000);
+}
+
+TEST(network, input_with_padding_values) {
+  // the greatest key is also the padding: it must still come out
+  std::vector<int32_t> input = {std::numeric_limits<int32_t>::max(),
+                                std::numeric_limits<int32_t>::min(),
+                                0,
+                                std::numeric_limits<int32_t>::max(),
+                                -1};
+  std::vector<int32_t> expect = input;
+  std::sort(expect.begin(), expect.end());
+  alg::Network<int32_t>::sort(input, 0, input.size() - 1);
+  ASSERT_EQ(input, expect);
+
+  double const inf = std::numeric_limits<double>::infinity();
+  std::vector<double> doubles = {inf, 1.5, -inf, inf, 0.0, -2.5, 1e300};
+  std::vector<double> expect_doubles = doubles;
+  std::sort(expect_doubles.begin(), expect_doubles.end());
+  alg::Network<double>::sort(doubles, 0, doubles.size() - 1);
+  ASSERT_EQ(doubles, expect_doubles);
+}
+
+TEST(network, faster_than_insertion) {
+  size_t const n = alg::Network<int>::MAX, rounds = 1 << 15;
+  std::vector<std::vector<int>> inputs(rounds, std::vector<int>(n));
+  alg::RandIntGen<int> gen(0, 1000000);
+  for (auto& input : inputs) {
+    for (auto& x : input) {
+      x = gen.gen();
+    }
+  }
+  auto networked = inputs;
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  for (auto& input : inputs) {
+    alg::Insertion<int>::sort(input);
+  }
+  timer.stop();
+  std::cout << "insertion, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  timer.reset();
+  timer.start();
+  for (auto& input : networked) {
+    alg::Network<int>::sort(input, 0, n - 1);
+  }
+  timer.stop();
+  std::cout << "network, elapsed time: " << timer.miliseconds() << "ms\n";
+
+  ASSERT_EQ(networked, inputs);
+}
+#else
+TEST(network, disabled_without_gcc) {
+  // the recursive sorts keep their `Insertion` base case
+  ASSERT_FALSE(alg::Network<int>::ENABLED);
+  ASSERT_FALSE(alg::Network<double>::ENABLED);
+}
+#endif
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
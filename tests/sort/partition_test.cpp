@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <random/prng.hpp>
+#include <sort/partition.hpp>
+#include <sort/quick.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+template <typename T>
+using Simd = alg::SimdPartition<T>;
+
+template <typename T>
+static std::vector<T> random_keys(size_t const n,
+                                  uint64_t const range,
+                                  uint64_t const seed) {
+  alg::Xoshiro256 g(seed);
+  std::vector<T> a(n);
+  for (auto& x : a) {
+    // negative keys too
+    x = static_cast<T>(static_cast<int64_t>(alg::bounded(g, range)) -
+                       static_cast<int64_t>(range / 2));
+  }
+  return a;
+}
+
+static std::vector<Simd<int>::Isa> kernels() {
+  std::vector<Simd<int>::Isa> r;
+  for (auto const k : {Simd<int>::Isa::Scalar, Simd<int>::Isa::Avx2,
+                       Simd<int>::Isa::Avx512}) {
+    if (Simd<int>::supported(k)) {
+      r.push_back(k);
+    }
+  }
+  return r;
+}
+
+// split at `m` around `pivot`, and the same keys as before
+template <typename T>
+static void check(std::vector<T> const& input, T const pivot) {
+  for (auto const k : kernels()) {
+    std::vector<T> a = input;
+    auto const isa = static_cast<typename Simd<T>::Isa>(k);
+    size_t const m = Simd<T>::partition(a.data(), a.size(), pivot, isa);
+    ASSERT_LE(m, a.size());
+    for (size_t i = 0; i < m; i++) {
+      ASSERT_FALSE(pivot < a[i]) << "kernel " << static_cast<int>(k);
+    }
+    for (size_t i = m; i < a.size(); i++) {
+      ASSERT_FALSE(a[i] < pivot) << "kernel " << static_cast<int>(k);
+    }
+    std::vector<T> b = input;
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    ASSERT_EQ(a, b);
+  }
+}
+
+template <typename T>
+static void check_sizes() {
+  for (size_t n = 0; n <= 200; n++) {
+    std::vector<T> const a = random_keys<T>(n, 1000, n);
+    check(a, n == 0 ? T(0) : a[n / 2]);
+    check(a, T(-1000));
+    check(a, T(1000));
+  }
+  std::vector<T> const big = random_keys<T>(100003, 1 << 20, 7);
+  check(big, big[5]);
+  check(random_keys<T>(100003, 3, 8), T(0));
+}
+
+TEST(simd_partition, int32) {
+  check_sizes<int32_t>();
+}
+
+TEST(simd_partition, int64) {
+  check_sizes<int64_t>();
+}
+
+TEST(simd_partition, float) {
+  check_sizes<float>();
+}
+
+TEST(simd_partition, double) {
+  check_sizes<double>();
+}
+
+TEST(simd_partition, equal_keys_split_in_halves) {
+  std::vector<int> const same(100000, 42);
+  for (auto const k : kernels()) {
+    std::vector<int> a = same;
+    size_t const m = Simd<int>::partition(a.data(), a.size(), 42, k);
+    ASSERT_GT(m, a.size() / 4);
+    ASSERT_LT(m, a.size() * 3 / 4);
+  }
+  // no quadratic time on all equal keys
+  std::vector<int64_t> b(1 << 20, 7);
+  alg::QuickX<int64_t>::sort(b);
+  ASSERT_EQ(b, std::vector<int64_t>(1 << 20, 7));
+}
+
+TEST(simd_partition, quick_sort_and_select) {
+  std::vector<double> a = random_keys<double>(300000, 1000, 9);
+  std::vector<double> b = a;
+  std::sort(b.begin(), b.end());
+  for (size_t const k : {size_t(0), size_t(1234), a.size() - 1}) {
+    std::vector<double> c = a;
+    ASSERT_EQ(alg::QuickSelect<double>::select(c, k), b[k]);
+  }
+  alg::QuickX<double>::sort(a);
+  ASSERT_EQ(a, b);
+}
+
+TEST(simd_partition, throughput) {
+  size_t const n = 1 << 22;
+  std::vector<int> const input = random_keys<int>(n, 1 << 30, 10);
+  alg::Timer<HightResolutionClock> timer;
+  for (auto const k : kernels()) {
+    std::vector<int> a = input;
+    timer.reset();
+    timer.start();
+    Simd<int>::partition(a.data(), n, 0, k);
+    timer.stop();
+    std::cout << "kernel " << static_cast<int>(k) << ": "
+              << timer.miliseconds() << "ms\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
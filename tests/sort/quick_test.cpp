@@ -1,5 +1,9 @@
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <random/random.hpp>
@@ -41,6 +45,125 @@ TEST(plain_order, input_with_int_vec) {
   }
 }
 
+// test parallel quick
+TEST(parallel, input_with_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10};
+
+  alg::ParallelQuickX<int>::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(parallel, speedup_against_quickx) {
+  uint64_t const n = 1 << 21;
+  std::vector<uint64_t> input(n);
+  alg::RandIntGen<uint64_t> gen(0, UINT64_MAX);
+  for (uint64_t i = 0; i < n; i++) {
+    input[i] = gen.gen();
+  }
+  std::vector<uint64_t> serial = input;
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::QuickX<uint64_t>::sort(serial);
+  timer.stop();
+  double const serial_ms = timer.miliseconds();
+
+  alg::Scheduler& sched = alg::Scheduler::instance();
+  timer.reset();
+  timer.start();
+  alg::ParallelQuickX<uint64_t>::sort(input, sched);
+  timer.stop();
+  double const parallel_ms = timer.miliseconds();
+
+  std::cout << "QuickX: " << serial_ms << "ms, ParallelQuickX with "
+            << sched.concurrency() << " threads: " << parallel_ms
+            << "ms, speedup: " << serial_ms / parallel_ms << '\n';
+
+  ASSERT_EQ(input, serial);
+}
+
+TEST(parallel, with_dedicated_scheduler_and_greater_order) {
+  uint64_t const n = 100000;
+  std::vector<int> input(n);
+  alg::RandIntGen<int> gen(0, 100);
+  for (uint64_t i = 0; i < n; i++) {
+    input[i] = gen.gen();
+  }
+
+  alg::Scheduler sched(4);
+  alg::ParallelQuickX<int, alg::Order<int>::greater>::sort(input, sched);
+
+  for (uint64_t i = 1; i < n; i++) {
+    ASSERT_GE(input[i - 1], input[i]);
+  }
+}
+
+// test introspective quick
+TEST(intro, input_with_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10};
+
+  alg::IntroQuickX<int>::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(intro, input_with_patterns) {
+  for (int n : {0, 1, 2, 23, 24, 25, 128, 129, 1000, 100000}) {
+    std::vector<std::vector<int>> inputs(6, std::vector<int>(n));
+    alg::RandIntGen<int> gen(0, 1 << 30);
+    for (int i = 0; i < n; i++) {
+      inputs[0][i] = gen.gen();                   // random
+      inputs[1][i] = i;                           // sorted
+      inputs[2][i] = n - i;                       // reversed
+      inputs[3][i] = 7;                           // all equal
+      inputs[4][i] = gen.gen() % 4;               // few unique
+      inputs[5][i] = i < n / 2 ? i : n - i;       // organ pipe
+    }
+    for (auto& input : inputs) {
+      std::vector<int> expect = input;
+      std::sort(expect.begin(), expect.end());
+      alg::IntroQuickX<int>::sort(input);
+      ASSERT_EQ(input, expect);
+    }
+  }
+}
+
+TEST(intro, input_with_str_vec_and_greater_order) {
+  std::vector<std::string> input = {"bug", "bed", "be", "cat", "alpha", "zoo"};
+  std::vector<std::string> expect = {"zoo", "cat", "bug", "bed", "be", "alpha"};
+
+  alg::IntroQuickX<std::string, alg::Order<std::string>::greater>::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(intro, against_quickx) {
+  uint64_t const n = 1 << 21;
+  std::vector<int> input(n);
+  alg::RandIntGen<int> gen(0, 1 << 30);
+  for (uint64_t i = 0; i < n; i++) {
+    input[i] = gen.gen();
+  }
+  std::vector<int> quick = input;
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::QuickX<int>::sort(quick);
+  timer.stop();
+  std::cout << "QuickX: " << timer.miliseconds() << "ms\n";
+
+  timer.reset();
+  timer.start();
+  alg::IntroQuickX<int>::sort(input);
+  timer.stop();
+  std::cout << "IntroQuickX: " << timer.miliseconds() << "ms\n";
+
+  ASSERT_EQ(input, quick);
+}
+
 /* TEST(plain_order, input_with_double_vec) { */
 /*   std::vector<double> input = {6.1, 4.0,  10.9, 9.8, 7.3, 7.4, */
 /*                                8.4, 10.6, 8.6,  9.2, 10.7}; */
@@ -409,6 +532,189 @@ TEST(plain_order, input_with_int_vec) {
 /*   ASSERT_EQ(output, expect); */
 /* } */
 
+// test comparators given as function objects and lambdas
+TEST(comparator, function_object_and_lambda) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {10, 10, 10, 9, 9, 8, 8, 7, 7, 6, 4};
+
+  auto greater = input;
+  alg::QuickX<int, std::greater<int>{}>::sort(greater);
+  ASSERT_EQ(greater, expect);
+
+  auto lambda = input;
+  auto cmp = [](int const& t1, int const& t2) { return t1 > t2; };
+  alg::IntroQuickX<int, cmp>::sort(lambda);
+  ASSERT_EQ(lambda, expect);
+}
+
+TEST(comparator, function_object_against_function_pointer) {
+  uint64_t const n = 1 << 20;
+  std::vector<double> input(n);
+  alg::RandIntGen<int64_t> gen(INT32_MIN, INT32_MAX);
+  for (uint64_t i = 0; i < n; i++) {
+    input[i] = static_cast<double>(gen.gen()) / 3;
+  }
+  auto output = input;
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::Quick<double, alg::Order<double>::greater>::sort(input);
+  timer.stop();
+  std::cout << "function pointer, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  timer.reset();
+  timer.start();
+  alg::Quick<double, std::greater<double>{}>::sort(output);
+  timer.stop();
+  std::cout << "function object, elapsed time: " << timer.miliseconds()
+            << "ms\n";
+
+  ASSERT_EQ(input, output);
+}
+
+// test three-way quick
+TEST(three_way, input_with_duplicated_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10};
+
+  alg::Quick3Way<int>::sort(input);
+
+  ASSERT_EQ(input, expect);
+
+  uint64_t const n = 1 << 16;
+  std::vector<int> few_keys(n);
+  alg::RandIntGen<int> gen(0, 7);
+  for (uint64_t i = 0; i < n; i++) {
+    few_keys[i] = gen.gen();
+  }
+  auto sorted = few_keys;
+  std::sort(sorted.begin(), sorted.end());
+  alg::Quick3Way<int>::sort(few_keys);
+  ASSERT_EQ(few_keys, sorted);
+}
+
+TEST(three_way, input_with_str_vec_and_function_object) {
+  std::vector<std::string> input = {"egg", "cat", "apple", "dog", "cat"};
+  std::vector<std::string> expect = {"egg", "dog", "cat", "cat", "apple"};
+
+  alg::Quick3Way<std::string, [](std::string const& t1,
+                                  std::string const& t2) {
+    return t2.compare(t1);
+  }>::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+// test multi-rank selection
+TEST(multi_select, input_with_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {10, 4, 7, 9};
+
+  auto const output = alg::MultiSelect<int>::select(input, {8, 0, 3, 6});
+
+  ASSERT_EQ(output, expect);
+  ASSERT_THROW(alg::MultiSelect<int>::select(input, {11}), std::runtime_error);
+}
+
+TEST(multi_select, ranks_in_place_with_random_vec) {
+  size_t const n = 1 << 20;
+  std::vector<uint64_t> input(n);
+  alg::RandIntGen<uint64_t> gen(0, 1000);
+  for (auto& x : input) {
+    x = gen.gen();
+  }
+  std::vector<uint64_t> expect = input;
+  std::sort(expect.begin(), expect.end());
+  std::vector<size_t> const ranks = {0, n / 2, n * 9 / 10, n * 99 / 100,
+                                     n * 999 / 1000, n - 1, n / 2};
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  auto const output = alg::MultiSelect<uint64_t>::select(input, ranks);
+  timer.stop();
+  std::cout << "elapsed time: " << timer.miliseconds() << "ms\n";
+
+  for (size_t i = 0; i < ranks.size(); i++) {
+    ASSERT_EQ(output[i], expect[ranks[i]]);
+    // partitioned around every requested rank
+    size_t const r = ranks[i];
+    ASSERT_TRUE(std::all_of(input.begin(), input.begin() + r,
+                            [&](uint64_t x) { return x <= input[r]; }));
+    ASSERT_TRUE(std::all_of(input.begin() + r, input.end(),
+                            [&](uint64_t x) { return x >= input[r]; }));
+  }
+}
+
+TEST(multi_select, quantiles_with_sorted_and_greater_order) {
+  std::vector<int> input(1000);
+  for (int i = 0; i < 1000; i++) {
+    input[i] = i + 1;
+  }
+  auto ascending = input;
+  auto const q = alg::MultiSelect<int>::quantiles(ascending,
+                                                  {0, 0.5, 0.9, 0.99, 1});
+  ASSERT_EQ(q, std::vector<int>({1, 500, 900, 990, 1000}));
+
+  auto const top = alg::MultiSelect<int, std::greater<int>{}>::select(
+      input, {0, 1, 2});
+  ASSERT_EQ(top, std::vector<int>({1000, 999, 998}));
+  ASSERT_THROW(alg::MultiSelect<int>::quantiles(input, {1.5}),
+               std::runtime_error);
+}
+
+TEST(incremental, yields_in_order) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = input;
+  std::sort(expect.begin(), expect.end());
+
+  alg::IncrementalQuick<int> iqs(input);
+  ASSERT_EQ(iqs.take(3), std::vector<int>({4, 6, 7}));
+  ASSERT_EQ(iqs.position(), 3);
+  std::vector<int> output = {4, 6, 7};
+  while (iqs.has_next()) {
+    output.push_back(iqs.next());
+  }
+  ASSERT_EQ(output, expect);
+  ASSERT_THROW(iqs.next(), std::runtime_error);
+  ASSERT_TRUE(iqs.take(5).empty());
+}
+
+TEST(incremental, pages_against_full_sort) {
+  size_t const n = 1 << 20, page = 50;
+  std::vector<std::string> input(n);
+  alg::RandIntGen<int> gen(0, 1 << 30);
+  for (auto& x : input) {
+    x = std::to_string(gen.gen());
+  }
+  std::vector<std::string> expect = input;
+  std::sort(expect.begin(), expect.end(), std::greater<std::string>{});
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::IncrementalQuick<std::string, std::greater<std::string>{}> iqs(input);
+  auto const first = iqs.take(page);
+  auto const second = iqs.take(page);
+  timer.stop();
+  std::cout << "two pages: " << timer.miliseconds() << "ms\n";
+  for (size_t i = 0; i < page; i++) {
+    ASSERT_EQ(first[i], expect[i]);
+    ASSERT_EQ(second[i], expect[page + i]);
+  }
+
+  std::vector<std::string> a = input;
+  timer.reset();
+  timer.start();
+  alg::QuickX<std::string, std::greater<std::string>{}>::sort(a);
+  timer.stop();
+  std::cout << "full QuickX sort: " << timer.miliseconds() << "ms\n";
+
+  // and the rest still comes out sorted
+  for (size_t i = 2 * page; i < n; i++) {
+    ASSERT_EQ(iqs.next(), expect[i]);
+  }
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <random/random.hpp>
+#include <sort/radix.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+template <typename T>
+static void expect_sorted_like_std(std::vector<T> input) {
+  std::vector<T> expect = input;
+  std::sort(expect.begin(), expect.end());
+  alg::LSD<T>::sort(input);
+  ASSERT_EQ(input, expect);
+}
+
+TEST(lsd, input_with_int_vec) {
+  std::vector<int> input = {6, 4, 10, 9, 7, 7, 8, 10, 8, 9, 10};
+  std::vector<int> expect = {4, 6, 7, 7, 8, 8, 9, 9, 10, 10, 10};
+
+  alg::LSD<int>::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(lsd, input_with_signed_and_extreme_values) {
+  expect_sorted_like_std<int8_t>({3, -1, 127, -128, 0, -1, 5});
+  expect_sorted_like_std<int16_t>({300, -1, 32767, -32768, 0, 255, -256});
+  expect_sorted_like_std<int64_t>({std::numeric_limits<int64_t>::min(),
+                                   -1,
+                                   0,
+                                   1,
+                                   std::numeric_limits<int64_t>::max(),
+                                   -4294967296,
+                                   4294967296});
+  expect_sorted_like_std<uint64_t>({UINT64_MAX, 0, 1, 1ull << 63, 255, 256});
+}
+
+TEST(lsd, input_with_double_vec) {
+  std::vector<double> input = {6.1,  -4.0, 10.9, 9.8,  -7.3, 7.4,
+                               -0.5, 10.6, 0.0,  1e-300, -1e300};
+  std::vector<double> expect = {-1e300, -7.3, -4.0, -0.5, 0.0,  1e-300,
+                                6.1,    7.4,  9.8,  10.6, 10.9};
+
+  alg::LSD<double>::sort(input);
+
+  for (size_t i = 0; i < input.size(); i++) {
+    ASSERT_DOUBLE_EQ(input[i], expect[i]);
+  }
+
+  float const inf = std::numeric_limits<float>::infinity();
+  expect_sorted_like_std<float>({1.5f, -2.5f, -inf, inf, 0.25f, -0.25f});
+}
+
+TEST(lsd, input_with_random_vec) {
+  uint64_t const n = 1 << 20;
+  std::vector<uint64_t> input(n);
+  alg::RandIntGen<uint64_t> gen(0, UINT64_MAX);
+  for (uint64_t i = 0; i < n; i++) {
+    input[i] = gen.gen();
+  }
+  std::vector<uint64_t> expect = input;
+  std::sort(expect.begin(), expect.end());
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::LSD<uint64_t>::sort(input);
+  timer.stop();
+  std::cout << "elapsed time: " << timer.miliseconds() << "ms\n";
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(lsd, small_keys_skip_constant_bytes) {
+  uint64_t const n = 100000;
+  std::vector<int64_t> input(n);
+  alg::RandIntGen<int64_t> gen(0, 1000000);
+  for (uint64_t i = 0; i < n; i++) {
+    input[i] = gen.gen();
+  }
+  expect_sorted_like_std(input);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
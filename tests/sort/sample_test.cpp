@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <parallel/scheduler.hpp>
+#include <random/prng.hpp>
+#include <sort/merge.hpp>
+#include <sort/quick.hpp>
+#include <sort/sample.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+static std::vector<int> random_ints(size_t const n,
+                                    uint64_t const range,
+                                    uint64_t const seed) {
+  alg::Xoshiro256 g(seed);
+  std::vector<int> a(n);
+  for (auto& x : a) {
+    x = static_cast<int>(alg::bounded(g, range));
+  }
+  return a;
+}
+
+// sorted by `SampleSort` and by `std::sort`, the same
+template <typename T, auto cmp = alg::Order<T>::less>
+static void check(std::vector<T> const& input, alg::Scheduler& sched) {
+  std::vector<T> a = input, b = input;
+  alg::SampleSort<T, cmp>::sort(a, sched);
+  std::sort(b.begin(), b.end(), cmp);
+  ASSERT_EQ(a, b);
+}
+
+TEST(sample_sort, input_shapes) {
+  alg::Scheduler sched(4);
+  for (size_t const n : {0, 1, 2, 1000, 4097, 20000, 100003, 1 << 20}) {
+    check(random_ints(n, 1 << 30, n), sched);
+    check(random_ints(n, 4, n + 1), sched);
+    check(std::vector<int>(n, 7), sched);
+
+    std::vector<int> sorted = random_ints(n, 1 << 30, n + 2);
+    std::sort(sorted.begin(), sorted.end());
+    check(sorted, sched);
+    std::reverse(sorted.begin(), sorted.end());
+    check(sorted, sched);
+  }
+}
+
+TEST(sample_sort, heavy_keys) {
+  alg::Scheduler sched(4);
+  // half the items one key, the rest spread
+  std::vector<int> a = random_ints(500000, 1 << 30, 3);
+  for (size_t i = 0; i < a.size(); i += 2) {
+    a[i] = 12345;
+  }
+  check(a, sched);
+  check<int, std::greater<int>{}>(a, sched);
+}
+
+TEST(sample_sort, non_trivial_items) {
+  alg::Scheduler sched(3);
+  std::vector<std::string> words;
+  for (int const x : random_ints(200000, 1 << 16, 4)) {
+    words.push_back("key-" + std::to_string(x));
+  }
+  check(words, sched);
+  // more than one block of `double`, fewer items per block
+  std::vector<double> d(300000);
+  alg::Xoshiro256 g(5);
+  for (auto& x : d) {
+    x = alg::unit(g);
+  }
+  check(d, sched);
+}
+
+// a record of 2 KiB, one per block of `SampleSort`
+struct Wide {
+  int key;
+  // copy of `key`, to tell a torn move
+  int check;
+  std::array<char, 2040> payload;
+
+  bool operator<(Wide const& o) const { return key < o.key; }
+};
+
+TEST(sample_sort, large_records_uneven_stripes) {
+  alg::Scheduler sched(2);
+  // two stripes, the last one item longer
+  size_t const n = 2 * (1 << 16) + 1;
+  std::vector<int> keys = random_ints(n, 1 << 30, 7);
+  std::vector<Wide> a(n);
+  for (size_t i = 0; i < n; i++) {
+    a[i].key = a[i].check = keys[i];
+  }
+  alg::SampleSort<Wide>::sort(a, sched);
+  std::sort(keys.begin(), keys.end());
+  for (size_t i = 0; i < n; i++) {
+    ASSERT_EQ(a[i].key, keys[i]);
+    ASSERT_EQ(a[i].check, keys[i]);
+  }
+}
+
+TEST(sample_sort, against_quick_and_merge) {
+  size_t const n = 1 << 21;
+  std::vector<int> const input = random_ints(n, 1 << 30, 6);
+  alg::Timer<HightResolutionClock> timer;
+  for (size_t const threads : {1, 2, 4}) {
+    alg::Scheduler sched(threads);
+    std::vector<int> a = input;
+    timer.reset();
+    timer.start();
+    alg::SampleSort<int>::sort(a, sched);
+    timer.stop();
+    ASSERT_TRUE(std::is_sorted(a.begin(), a.end()));
+    std::cout << threads << " threads: sample sort " << timer.miliseconds()
+              << "ms";
+
+    a = input;
+    timer.reset();
+    timer.start();
+    alg::ParallelQuickX<int>::sort(a, sched);
+    timer.stop();
+    std::cout << ", parallel quick " << timer.miliseconds() << "ms\n";
+  }
+
+  std::vector<int> a = input;
+  timer.reset();
+  timer.start();
+  alg::QuickX<int>::sort(a);
+  timer.stop();
+  std::cout << "quick " << timer.miliseconds() << "ms";
+
+  a = input;
+  timer.reset();
+  timer.start();
+  alg::Merge<int>::sort(a);
+  timer.stop();
+  std::cout << ", merge " << timer.miliseconds() << "ms\n";
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
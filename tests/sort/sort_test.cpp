@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <random/prng.hpp>
+#include <sort/sort.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+static std::vector<int> random_ints(size_t const n,
+                                    uint64_t const range,
+                                    uint64_t const seed) {
+  alg::Xoshiro256 g(seed);
+  std::vector<int> a(n);
+  for (auto& x : a) {
+    x = static_cast<int>(alg::bounded(g, range));
+  }
+  return a;
+}
+
+// record without `<`, so no radix sort
+struct Record {
+  int key;
+  int value;
+};
+
+static bool key_less(Record const& x, Record const& y) {
+  return x.key < y.key;
+}
+
+static bool key_greater(Record const& x, Record const& y) {
+  return x.key > y.key;
+}
+
+static int key_three_way(Record const& x, Record const& y) {
+  return x.key < y.key ? -1 : (x.key > y.key ? 1 : 0);
+}
+
+static std::vector<Record> records(std::vector<int> const& keys) {
+  std::vector<Record> r;
+  for (size_t i = 0; i < keys.size(); i++) {
+    r.push_back({keys[i], static_cast<int>(i)});
+  }
+  return r;
+}
+
+TEST(adaptive_sort, dispatch_by_shape) {
+  size_t const n = 100000;
+  alg::SortStats stats;
+
+  std::vector<int> tiny = {3, 1, 2};
+  alg::sort(tiny, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::Insertion);
+  ASSERT_EQ(tiny, std::vector<int>({1, 2, 3}));
+
+  std::vector<int> one = {1};
+  alg::sort(one, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::None);
+
+  // integers: radix unless already in order
+  std::vector<int> a = random_ints(n, 1 << 30, 1);
+  alg::sort(a, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::Radix);
+  ASSERT_TRUE(std::is_sorted(a.begin(), a.end()));
+  ASSERT_EQ(stats.n, n);
+
+  std::swap(a[10], a[n / 2]);
+  alg::sort(a, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::NaturalMerge);
+  ASSERT_GE(stats.ascending, 0.9);
+  ASSERT_TRUE(std::is_sorted(a.begin(), a.end()));
+
+  std::reverse(a.begin(), a.end());
+  alg::sort(a, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::NaturalMerge);
+  ASSERT_GE(stats.descending, 0.9);
+  ASSERT_TRUE(std::is_sorted(a.begin(), a.end()));
+
+  // other orders and types go through compares
+  std::vector<int> b = random_ints(n, 1 << 30, 2);
+  alg::sort<int, std::greater<int>{}>(b, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::IntroSort);
+  ASSERT_LT(stats.duplicates, 0.1);
+  ASSERT_TRUE(std::is_sorted(b.rbegin(), b.rend()));
+
+  std::vector<Record> few = records(random_ints(n, 16, 3));
+  alg::sort<Record, key_less>(few, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::IntroSort);
+  ASSERT_GE(stats.duplicates, 0.5);
+  ASSERT_TRUE(std::is_sorted(few.begin(), few.end(), key_less));
+
+  std::vector<Record> many = records(random_ints(n, 1 << 30, 4));
+  alg::sort<Record, key_greater>(many, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::IntroSort);
+  ASSERT_LT(stats.duplicates, 0.1);
+  ASSERT_TRUE(std::is_sorted(many.begin(), many.end(), key_greater));
+
+  std::vector<std::string> words;
+  for (int const x : random_ints(n, 1 << 20, 5)) {
+    words.push_back(std::to_string(x));
+  }
+  alg::sort(words, &stats);
+  ASSERT_EQ(stats.algorithm, alg::SortAlgorithm::Radix);
+  ASSERT_TRUE(std::is_sorted(words.begin(), words.end()));
+  std::cout << "strings: " << alg::to_string(stats.algorithm) << "\n";
+}
+
+TEST(adaptive_sort, against_fixed_choices) {
+  size_t const n = 1 << 20;
+  std::vector<std::pair<std::string, std::vector<Record>>> shapes;
+  shapes.emplace_back("random", records(random_ints(n, 1 << 30, 6)));
+  shapes.emplace_back("few_unique", records(random_ints(n, 8, 7)));
+  std::vector<int> sorted = random_ints(n, 1 << 30, 8);
+  std::sort(sorted.begin(), sorted.end());
+  shapes.emplace_back("sorted", records(sorted));
+
+  alg::Timer<HightResolutionClock> timer;
+  for (auto const& [name, input] : shapes) {
+    std::vector<Record> a = input;
+    alg::SortStats stats;
+    timer.reset();
+    timer.start();
+    alg::sort<Record, key_less>(a, &stats);
+    timer.stop();
+    ASSERT_TRUE(std::is_sorted(a.begin(), a.end(), key_less));
+    std::cout << name << ": " << alg::to_string(stats.algorithm) << " "
+              << timer.miliseconds() << "ms";
+
+    a = input;
+    timer.reset();
+    timer.start();
+    alg::IntroQuickX<Record, key_less>::sort(a);
+    timer.stop();
+    std::cout << ", introsort " << timer.miliseconds() << "ms";
+
+    a = input;
+    timer.reset();
+    timer.start();
+    alg::Quick3Way<Record, key_three_way>::sort(a);
+    timer.stop();
+    std::cout << ", quick 3-way " << timer.miliseconds() << "ms\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
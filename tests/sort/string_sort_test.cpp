@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <random/random.hpp>
+#include <sort/quick.hpp>
+#include <sort/string_sort.hpp>
+#include <time/timer.hpp>
+
+#include <gtest/gtest.h>
+
+using Vector = std::vector<std::string>;
+
+static std::vector<size_t> brute_force_lcp(Vector const& a) {
+  std::vector<size_t> lcp(a.size(), 0);
+  for (size_t i = 1; i < a.size(); i++) {
+    size_t k = 0;
+    while (k < a[i - 1].size() && k < a[i].size() && a[i - 1][k] == a[i][k]) {
+      k++;
+    }
+    lcp[i] = k;
+  }
+  return lcp;
+}
+
+// strings over a tiny alphabet, so that long shared prefixes are common
+static Vector random_strings(size_t const n, int const max_len) {
+  alg::RandIntGen<int> len_gen(0, max_len);
+  alg::RandIntGen<int> char_gen('a', 'c');
+  Vector a(n);
+  for (auto& s : a) {
+    int const len = len_gen.gen();
+    for (int i = 0; i < len; i++) {
+      s.push_back(static_cast<char>(char_gen.gen()));
+    }
+  }
+  return a;
+}
+
+TEST(quick3string, input_with_str_vec) {
+  Vector input = {"she", "sells", "seashells", "by", "the", "sea", "shore",
+                  "the", "shells", "she", "sells", "are", "surely",
+                  "seashells", ""};
+  Vector expect = input;
+  std::sort(expect.begin(), expect.end());
+
+  std::vector<size_t> lcp;
+  alg::Quick3String::sort(input, lcp);
+
+  ASSERT_EQ(input, expect);
+  ASSERT_EQ(lcp, brute_force_lcp(expect));
+}
+
+TEST(msd, input_with_str_vec) {
+  Vector input = {"bug", "bed", "be", "cat", "alpha", "zoo"};
+  Vector expect = {"alpha", "be", "bed", "bug", "cat", "zoo"};
+
+  alg::MSD::sort(input);
+
+  ASSERT_EQ(input, expect);
+}
+
+TEST(msd, lcp_with_random_vec) {
+  for (size_t n : {0, 1, 63, 64, 1000, 20000}) {
+    Vector input = random_strings(n, 12);
+    Vector expect = input;
+    std::sort(expect.begin(), expect.end());
+
+    std::vector<size_t> lcp;
+    alg::MSD::sort(input, lcp);
+
+    ASSERT_EQ(input, expect);
+    ASSERT_EQ(lcp, brute_force_lcp(expect));
+
+    input = random_strings(n, 12);
+    alg::Quick3String::sort(input, lcp);
+    expect = input;
+    std::sort(expect.begin(), expect.end());
+    ASSERT_EQ(lcp, brute_force_lcp(expect));
+  }
+}
+
+TEST(msd, shared_prefixes_against_quickx) {
+  size_t const n = 200000;
+  std::string const prefix = "https://example.com/api/v1/users/";
+  alg::RandIntGen<int> gen(0, 1000000);
+  Vector input(n);
+  for (auto& s : input) {
+    s = prefix + std::to_string(gen.gen());
+  }
+  Vector quick = input;
+  Vector three_way = input;
+
+  alg::Timer<HightResolutionClock> timer;
+  timer.start();
+  alg::QuickX<std::string>::sort(quick);
+  timer.stop();
+  std::cout << "QuickX: " << timer.miliseconds() << "ms\n";
+
+  timer.reset();
+  timer.start();
+  alg::Quick3String::sort(three_way);
+  timer.stop();
+  std::cout << "Quick3String: " << timer.miliseconds() << "ms\n";
+
+  timer.reset();
+  timer.start();
+  alg::MSD::sort(input);
+  timer.stop();
+  std::cout << "MSD: " << timer.miliseconds() << "ms\n";
+
+  ASSERT_EQ(input, quick);
+  ASSERT_EQ(three_way, quick);
+}
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}